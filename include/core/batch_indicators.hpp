@@ -0,0 +1,72 @@
+/**
+ * @file batch_indicators.hpp
+ * @brief Vectorized indicator kernels over whole price arrays (AVX2 with a scalar fallback).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace core::batch {
+
+/**
+ * Every kernel reads a contiguous input array and writes one output per
+ * input element into a caller-provided array of the same length, so research
+ * runs can keep one column per instrument and reuse the buffers. The AVX2
+ * versions are picked at run time when the CPU supports them; results match
+ * the scalar versions up to floating-point rounding (exactly for integers).
+ *
+ * Kernels throw std::invalid_argument on mismatched lengths or a zero window.
+ */
+
+/// True if the AVX2 kernels are in use.
+bool simdEnabled();
+
+/**
+ * @brief Switches the AVX2 kernels off (false) or back on where supported.
+ *
+ * For comparing against the scalar path; not thread-safe against running kernels.
+ */
+void setSimdEnabled(bool enabled);
+
+/**
+ * @brief Sum of the last @p window inputs at each position (fewer at the start).
+ */
+void rollingSum(std::span<const double> in, std::size_t window, std::span<double> out);
+
+/**
+ * @brief Exact rolling sum of fixed-point values (e.g. prices in ticks).
+ */
+void rollingSum(std::span<const int64_t> in, std::size_t window, std::span<int64_t> out);
+
+/**
+ * @brief Exponential moving average seeded with the first input.
+ * @param alpha Weight of each new input, in (0, 1]
+ */
+void ema(std::span<const double> in, double alpha, std::span<double> out);
+
+/**
+ * @brief Simple returns in[i] / in[i-1] - 1; out[0] is 0.
+ */
+void returns(std::span<const double> in, std::span<double> out);
+
+/**
+ * @brief Log returns log(in[i] / in[i-1]); out[0] is 0.
+ */
+void logReturns(std::span<const double> in, std::span<double> out);
+
+/**
+ * @brief Pearson correlation of two equally long series (0 if either is constant).
+ */
+double correlation(std::span<const double> x, std::span<const double> y);
+
+/**
+ * @brief Correlation of x[t] with y[t - lag] for every lag in [0, out.size()).
+ *
+ * Positive lags test whether @p y leads @p x.
+ */
+void crossCorrelation(std::span<const double> x, std::span<const double> y, std::span<double> out);
+
+}
@@ -0,0 +1,240 @@
+/**
+ * @file event_bus.hpp
+ * @brief Pre-allocated ring buffer with sequence barriers for pipelining feed, engine and consumers.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+/**
+ * @class Sequence
+ * @brief Position of a producer or consumer in a RingBuffer, alone on its cache line.
+ *
+ * -1 means nothing published / processed yet.
+ */
+class alignas(64) Sequence {
+public:
+    explicit Sequence(int64_t value = -1) : value_(value) {}
+
+    Sequence(const Sequence&) = delete;
+    Sequence& operator=(const Sequence&) = delete;
+
+    int64_t get() const { return value_.load(std::memory_order_acquire); }
+    void set(int64_t value) { value_.store(value, std::memory_order_release); }
+
+private:
+    std::atomic<int64_t> value_;
+};
+
+namespace detail {
+
+// Busy-spin for a while, then give the core away between checks.
+inline void backoff(unsigned& spins) {
+    if (++spins < 100) return;
+    std::this_thread::yield();
+}
+
+inline int64_t minimum(const std::vector<const Sequence*>& sequences, int64_t bound) {
+    int64_t low = bound;
+    for (const Sequence* s : sequences) {
+        low = std::min(low, s->get());
+    }
+    return low;
+}
+
+}
+
+/**
+ * @class SequenceBarrier
+ * @brief Tells a consumer how far it may read: up to the producer cursor and
+ * every upstream consumer it depends on.
+ */
+class SequenceBarrier {
+public:
+    SequenceBarrier(const Sequence& cursor, std::vector<const Sequence*> dependencies)
+        : cursor_(&cursor), dependencies_(std::move(dependencies)) {}
+
+    /**
+     * @brief Waits until @p sequence is readable.
+     * @return Highest readable sequence (>= @p sequence), or nullopt once alerted
+     */
+    std::optional<int64_t> waitFor(int64_t sequence) const {
+        unsigned spins = 0;
+        while (true) {
+            int64_t available = detail::minimum(dependencies_, cursor_->get());
+            if (available >= sequence) return available;
+            if (alerted()) return std::nullopt;
+            detail::backoff(spins);
+        }
+    }
+
+    /// Wakes the waiting consumer so it can shut down.
+    void alert() { alerted_.store(true, std::memory_order_release); }
+    bool alerted() const { return alerted_.load(std::memory_order_acquire); }
+
+private:
+    const Sequence* cursor_;
+    std::vector<const Sequence*> dependencies_;
+    std::atomic<bool> alerted_{false};
+};
+
+/**
+ * @class RingBuffer
+ * @brief Fixed ring of pre-allocated events shared by one producer and any number of consumers.
+ *
+ * The producer claims a slot with next(), fills it in place and publish()es
+ * it; consumers read slots through a SequenceBarrier and advance their own
+ * Sequence. The producer never laps a gating consumer, so a slot is only
+ * reused once every gating consumer is done with it. Slots are constructed
+ * once up front and overwritten in place: nothing is allocated or locked per
+ * event. Only one thread may publish.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    /**
+     * @param capacity Number of slots; must be a power of two
+     */
+    explicit RingBuffer(std::size_t capacity)
+        : slots_(capacity), mask_(static_cast<int64_t>(capacity) - 1) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("RingBuffer capacity must be a power of two");
+        }
+    }
+
+    /**
+     * @brief Consumers the producer must not overtake. Call before publishing.
+     */
+    void addGatingSequences(std::initializer_list<const Sequence*> sequences) {
+        gating_.insert(gating_.end(), sequences.begin(), sequences.end());
+    }
+
+    /**
+     * @brief Barrier for a consumer that reads after the given upstream consumers (or
+     * straight after the producer if none).
+     */
+    SequenceBarrier newBarrier(std::vector<const Sequence*> dependencies = {}) const {
+        return SequenceBarrier(cursor_, std::move(dependencies));
+    }
+
+    /**
+     * @brief Claims the next slot, waiting while the ring is full.
+     */
+    int64_t next() {
+        int64_t sequence = ++claimed_;
+        int64_t wrap = sequence - static_cast<int64_t>(slots_.size());
+        if (wrap > cached_gate_) {
+            unsigned spins = 0;
+            while (wrap > (cached_gate_ = detail::minimum(gating_, claimed_ - 1))) {
+                detail::backoff(spins);
+            }
+        }
+        return sequence;
+    }
+
+    T& operator[](int64_t sequence) { return slots_[static_cast<std::size_t>(sequence & mask_)]; }
+    const T& operator[](int64_t sequence) const { return slots_[static_cast<std::size_t>(sequence & mask_)]; }
+
+    /**
+     * @brief Makes a claimed slot (and every one before it) visible to consumers.
+     */
+    void publish(int64_t sequence) { cursor_.set(sequence); }
+
+    /**
+     * @brief Claims a slot, lets @p fill write it, and publishes it.
+     */
+    template <typename Fill>
+    void publishEvent(Fill&& fill) {
+        int64_t sequence = next();
+        fill((*this)[sequence]);
+        publish(sequence);
+    }
+
+    /**
+     * @brief Waits until every gating consumer has processed everything published.
+     */
+    void drain() const {
+        unsigned spins = 0;
+        while (detail::minimum(gating_, std::numeric_limits<int64_t>::max()) < cursor_.get()) {
+            detail::backoff(spins);
+        }
+    }
+
+    const Sequence& cursor() const { return cursor_; }
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+    std::vector<T> slots_;
+    int64_t mask_;
+    Sequence cursor_;                        ///< Last published sequence
+    int64_t claimed_ = -1;                   ///< Last claimed sequence (producer only)
+    int64_t cached_gate_ = -1;               ///< Slowest gating consumer at last check
+    std::vector<const Sequence*> gating_;
+};
+
+/**
+ * @class BatchEventProcessor
+ * @brief Consumer loop that hands every readable event to a handler, a batch at a time.
+ *
+ * The handler is called as handler(event, sequence, end_of_batch) and may
+ * modify the event for downstream consumers. The processor's sequence only
+ * advances after a whole batch, so downstream stages and the producer see
+ * progress in batches rather than per event. Run it on its own thread.
+ */
+template <typename T, typename Handler>
+class BatchEventProcessor {
+public:
+    /**
+     * @param ring Ring to consume
+     * @param dependencies Upstream consumers this one must stay behind (none = straight after the producer)
+     * @param handler Called for every event
+     */
+    BatchEventProcessor(RingBuffer<T>& ring, std::vector<const Sequence*> dependencies, Handler handler)
+        : ring_(ring), barrier_(ring.newBarrier(std::move(dependencies))), handler_(std::move(handler)) {}
+
+    /// Progress of this consumer, for gating the producer or barriers of later stages.
+    const Sequence& sequence() const { return sequence_; }
+
+    /**
+     * @brief Processes events until halt() is called.
+     */
+    void run() {
+        int64_t next = sequence_.get() + 1;
+        while (auto available = barrier_.waitFor(next)) {
+            for (; next <= *available; ++next) {
+                try {
+                    handler_(ring_[next], next, next == *available);
+                } catch (const std::exception& ex) {
+                    std::cerr << "[EventBus] Handler failed: " << ex.what() << "\n";
+                }
+            }
+            sequence_.set(*available);
+        }
+    }
+
+    /**
+     * @brief Stops run() once it runs out of published events.
+     */
+    void halt() { barrier_.alert(); }
+
+private:
+    RingBuffer<T>& ring_;
+    SequenceBarrier barrier_;
+    Handler handler_;
+    Sequence sequence_;
+};
+
+}
@@ -0,0 +1,274 @@
+/**
+ * @file indicators.hpp
+ * @brief Rolling-window indicators with O(1) updates over fixed-capacity rings.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace core {
+
+/**
+ * @class FixedRing
+ * @brief Last N values in arrival order, stored in a buffer allocated once.
+ *
+ * Pushing into a full ring overwrites (and returns) the oldest value. Index 0
+ * is the oldest value, size() - 1 the newest. Single-threaded.
+ */
+template <typename T>
+class FixedRing {
+public:
+    /**
+     * @param capacity Maximum number of values kept; must be positive
+     */
+    explicit FixedRing(std::size_t capacity) : slots_(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("FixedRing capacity must be positive");
+        }
+    }
+
+    /**
+     * @brief Appends a value.
+     * @return The value it evicted, if the ring was full
+     */
+    std::optional<T> push(const T& value) {
+        std::optional<T> evicted;
+        if (size_ == slots_.size()) {
+            evicted = slots_[head_];
+            head_ = wrap(head_ + 1);
+        } else {
+            ++size_;
+        }
+        slots_[wrap(head_ + size_ - 1)] = value;
+        return evicted;
+    }
+
+    /// Removes the newest value. The ring must not be empty.
+    void popBack() { --size_; }
+
+    /// Removes the oldest value. The ring must not be empty.
+    void popFront() {
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    const T& operator[](std::size_t i) const { return slots_[wrap(head_ + i)]; }
+    T& operator[](std::size_t i) { return slots_[wrap(head_ + i)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return slots_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == slots_.size(); }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::vector<T> slots_;
+    std::size_t head_ = 0;  ///< Slot of the oldest value
+    std::size_t size_ = 0;
+
+    std::size_t wrap(std::size_t i) const { return i >= slots_.size() ? i - slots_.size() : i; }
+};
+
+/**
+ * @class RollingStats
+ * @brief Mean and variance of the last N values.
+ *
+ * Uses the windowed form of Welford's update, so each value costs O(1) and
+ * the variance does not suffer the cancellation of a sum-of-squares.
+ */
+class RollingStats {
+public:
+    explicit RollingStats(std::size_t window) : values_(window) {}
+
+    void add(double x) {
+        if (auto old = values_.push(x)) {
+            // replace the evicted value in place
+            double mean = mean_ + (x - *old) / static_cast<double>(values_.size());
+            m2_ += (x - *old) * (x - mean + *old - mean_);
+            mean_ = mean;
+        } else {
+            double delta = x - mean_;
+            mean_ += delta / static_cast<double>(values_.size());
+            m2_ += delta * (x - mean_);
+        }
+        if (m2_ < 0.0) m2_ = 0.0;  // rounding can leave a tiny negative
+    }
+
+    double mean() const { return mean_; }
+
+    /// Sum of the values in the window.
+    double sum() const { return mean_ * static_cast<double>(values_.size()); }
+
+    /// Population variance of the window.
+    double variance() const { return values_.empty() ? 0.0 : m2_ / static_cast<double>(values_.size()); }
+
+    double stddev() const { return std::sqrt(variance()); }
+
+    /// Values currently in the window, oldest first.
+    const FixedRing<double>& window() const { return values_; }
+
+    std::size_t size() const { return values_.size(); }
+    bool full() const { return values_.full(); }
+
+    void clear() {
+        values_.clear();
+        mean_ = 0.0;
+        m2_ = 0.0;
+    }
+
+private:
+    FixedRing<double> values_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+};
+
+/**
+ * @class RollingExtremum
+ * @brief Minimum or maximum of the last N values via a monotonic deque.
+ *
+ * The deque keeps only values that can still become the extremum, so each
+ * value is pushed and popped at most once: amortized O(1) per update.
+ * @tparam Better std::less<> for a minimum, std::greater<> for a maximum
+ */
+template <typename Better>
+class RollingExtremum {
+public:
+    explicit RollingExtremum(std::size_t window) : window_(window), candidates_(window) {}
+
+    void add(double x) {
+        // anything no better than the new value can never be the extremum again
+        while (!candidates_.empty() && !Better{}(candidates_.back().value, x)) candidates_.popBack();
+        candidates_.push({count_, x});
+        ++count_;
+        if (candidates_.front().index + window_ < count_) candidates_.popFront();
+    }
+
+    /// Extremum of the window; meaningless before the first add().
+    double value() const { return candidates_.front().value; }
+
+    bool empty() const { return candidates_.empty(); }
+
+    void clear() {
+        candidates_.clear();
+        count_ = 0;
+    }
+
+private:
+    struct Candidate {
+        uint64_t index;
+        double value;
+    };
+    std::size_t window_;
+    FixedRing<Candidate> candidates_;
+    uint64_t count_ = 0;  ///< Values added so far
+};
+
+using RollingMin = RollingExtremum<std::less<>>;
+using RollingMax = RollingExtremum<std::greater<>>;
+
+/**
+ * @class Ema
+ * @brief Exponential moving average; the first value seeds it.
+ */
+class Ema {
+public:
+    /**
+     * @param alpha Weight of each new value, in (0, 1]
+     */
+    explicit Ema(double alpha) : alpha_(alpha) {
+        if (!(alpha > 0.0 && alpha <= 1.0)) {
+            throw std::invalid_argument("Ema alpha must be in (0, 1]");
+        }
+    }
+
+    /// EMA with the conventional alpha = 2 / (period + 1).
+    static Ema withPeriod(std::size_t period) { return Ema(2.0 / (static_cast<double>(period) + 1.0)); }
+
+    void add(double x) {
+        value_ = seeded_ ? value_ + alpha_ * (x - value_) : x;
+        seeded_ = true;
+    }
+
+    /// Continues from a known average, e.g. the last output of batch::ema over history.
+    void seed(double value) {
+        value_ = value;
+        seeded_ = true;
+    }
+
+    double value() const { return value_; }
+    bool seeded() const { return seeded_; }
+
+private:
+    double alpha_;
+    double value_ = 0.0;
+    bool seeded_ = false;
+};
+
+/**
+ * @class RollingVwap
+ * @brief Volume-weighted average price of the last N prints.
+ */
+class RollingVwap {
+public:
+    explicit RollingVwap(std::size_t window) : prints_(window) {}
+
+    void add(double price, double quantity) {
+        if (auto old = prints_.push({price, quantity})) {
+            notional_ -= old->price * old->quantity;
+            volume_ -= old->quantity;
+        }
+        notional_ += price * quantity;
+        volume_ += quantity;
+    }
+
+    /// VWAP of the window, 0 if it holds no volume.
+    double value() const { return volume_ > 0.0 ? notional_ / volume_ : 0.0; }
+
+    double volume() const { return volume_; }
+
+private:
+    struct Print {
+        double price;
+        double quantity;
+    };
+    FixedRing<Print> prints_;
+    double notional_ = 0.0;
+    double volume_ = 0.0;
+};
+
+/**
+ * @class RollingZScore
+ * @brief How many standard deviations a value lies from the rolling mean.
+ */
+class RollingZScore {
+public:
+    explicit RollingZScore(std::size_t window) : stats_(window) {}
+
+    void add(double x) { stats_.add(x); }
+
+    /// Z-score of @p x against the window, 0 while the window has no spread.
+    double score(double x) const {
+        double sd = stats_.stddev();
+        return sd > 0.0 ? (x - stats_.mean()) / sd : 0.0;
+    }
+
+    const RollingStats& stats() const { return stats_; }
+
+private:
+    RollingStats stats_;
+};
+
+}
@@ -44,7 +44,14 @@ struct Order {
     Side side;                // BUY or SELL
     double price;             // Price per unit (ignored for market orders)
     uint32_t quantity;        // Total number of units
+    uint32_t display_quantity = 0; // Visible clip for iceberg orders (0 = fully displayed)
     uint64_t timestamp;       // Epoch time in microseconds
+    uint32_t owner_id = 0;    // Submitting participant (0 = anonymous market flow)
+
+    /**
+     * @brief Returns true if only part of the quantity is shown in the book.
+     */
+    bool isIceberg() const { return display_quantity > 0 && display_quantity < quantity; }
 
     /**
      * @brief Default constructor
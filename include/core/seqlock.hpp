@@ -0,0 +1,76 @@
+/**
+ * @file seqlock.hpp
+ * @brief Single-writer sequence lock for publishing small values to lock-free readers.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace core {
+
+/**
+ * @class SeqLock
+ * @brief Publishes a trivially copyable value that readers sample without locking.
+ *
+ * The writer bumps the sequence to an odd number, stores the payload, then
+ * bumps it to the next even number. Readers retry until they see the same
+ * even sequence before and after copying, so they never observe a torn value
+ * and never block the writer. Only one thread may call store() at a time.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+
+public:
+    SeqLock() { store(T{}); }
+
+    /**
+     * @brief Publishes a new value (single writer).
+     */
+    void store(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < kWords; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns a consistent copy of the last published value.
+     */
+    T load() const {
+        uint64_t words[kWords];
+        uint64_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> data_[kWords] = {};
+};
+
+}
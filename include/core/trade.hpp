@@ -25,6 +25,8 @@ struct Trade {
     uint32_t quantity;        ///< Number of units traded
     uint64_t timestamp;       ///< Execution timestamp (μs)
     core::Side side;          ///< Direction of the trade (BUY or SELL)
+    uint32_t buy_owner_id = 0;   ///< Owner of the buy order (0 = anonymous market flow)
+    uint32_t sell_owner_id = 0;  ///< Owner of the sell order (0 = anonymous market flow)
 
     /**
      * @brief Constructs a new Trade instance.
@@ -0,0 +1,105 @@
+/**
+ * @file checkpoint.hpp
+ * @brief Declares the binary checkpoint of engine state and its memory-mapped reader.
+ */
+
+#pragma once
+
+#include "engine/order_book.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @struct CheckpointBook
+ * @brief One book in a checkpoint; the views point into the mapped file.
+ */
+struct CheckpointBook {
+    std::string_view instrument;
+    BookState state;
+};
+
+/**
+ * @struct CheckpointStrategy
+ * @brief One strategy's saved state in a checkpoint; the views point into the mapped file.
+ */
+struct CheckpointStrategy {
+    std::string_view name;
+    std::string_view state;  ///< As written by Strategy::saveState
+};
+
+/**
+ * @class CheckpointWriter
+ * @brief Builds a checkpoint in memory and writes it out in one go.
+ *
+ * File layout, in host byte order with every section 8-byte aligned: the
+ * 8-byte magic "TRDCKPT\0", a uint32 version, the book and strategy counts,
+ * the journal sequence and engine time the checkpoint was taken at; then per
+ * book its counters, instrument and RestingOrder array; then per strategy its
+ * name and state bytes. Resting orders are stored exactly as they are used,
+ * so a reader maps the file and restores books straight from it.
+ */
+class CheckpointWriter {
+public:
+    /**
+     * @param journal_sequence First journal record not reflected in the checkpoint
+     * @param sim_time Engine clock at the checkpoint
+     */
+    CheckpointWriter(uint64_t journal_sequence, uint64_t sim_time);
+
+    void addBook(const std::string& instrument, const BookState& state);
+    void addStrategy(const std::string& name, const std::string& state);
+
+    /**
+     * @brief Writes the checkpoint, replacing @p path only once it is complete.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path);
+
+private:
+    std::vector<char> buffer_;
+    uint32_t book_count_ = 0;
+    uint32_t strategy_count_ = 0;
+};
+
+/**
+ * @class MappedCheckpoint
+ * @brief Read-only memory mapping of a checkpoint file.
+ *
+ * Opening validates the header and section sizes; nothing is copied, so the
+ * books() and strategies() views stay valid for the lifetime of this object.
+ */
+class MappedCheckpoint {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid checkpoint
+     */
+    explicit MappedCheckpoint(const std::string& path);
+    ~MappedCheckpoint();
+
+    MappedCheckpoint(const MappedCheckpoint&) = delete;
+    MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+
+    /// First journal record to replay after restoring.
+    uint64_t journalSequence() const { return journal_sequence_; }
+
+    /// Engine clock at the checkpoint.
+    uint64_t simTime() const { return sim_time_; }
+
+    const std::vector<CheckpointBook>& books() const { return books_; }
+    const std::vector<CheckpointStrategy>& strategies() const { return strategies_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    uint64_t journal_sequence_ = 0;
+    uint64_t sim_time_ = 0;
+    std::vector<CheckpointBook> books_;
+    std::vector<CheckpointStrategy> strategies_;
+};
+
+}
@@ -0,0 +1,157 @@
+/**
+ * @file clock.hpp
+ * @brief Declares the time source and timer scheduling interface shared by engine and strategies.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace engine {
+
+using TimerId = uint64_t;
+using TimerCallback = std::function<void()>;
+
+/**
+ * @class Clock
+ * @brief Source of time (epoch microseconds) and timers for strategies.
+ *
+ * Strategies never read the system clock or sleep directly; they ask their
+ * Clock for the time and schedule their periodic work on it. Backtests use a
+ * SimulationClock driven by tick timestamps, live runs a RealTimeClock.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    /**
+     * @brief Current time in epoch microseconds.
+     */
+    virtual uint64_t now() const = 0;
+
+    /**
+     * @brief Schedules a callback.
+     * @param delay_us Time from now until the first call
+     * @param interval_us Period for repeated calls, or 0 for a one-shot timer
+     * @param cb Callback to run
+     * @return Handle for cancel(); never 0
+     */
+    virtual TimerId schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) = 0;
+
+    /**
+     * @brief Cancels a timer. The callback is not invoked again once this returns.
+     *
+     * Cancelling 0 (a timer that was never scheduled) does nothing.
+     */
+    virtual void cancel(TimerId id) = 0;
+};
+
+/**
+ * @class TimerSet
+ * @brief Timer bookkeeping shared by the clock implementations (not thread-safe).
+ *
+ * Timers fire in (due time, creation order), which keeps replays deterministic.
+ */
+class TimerSet {
+public:
+    TimerId add(uint64_t due, uint64_t interval, TimerCallback cb);
+    bool remove(TimerId id);
+
+    /// Due time of the earliest timer, if any.
+    std::optional<uint64_t> nextDue() const;
+
+    /**
+     * @brief Takes the earliest timer if it is due at or before @p limit.
+     * @return Timer ID, due time and a copy of its callback
+     */
+    std::optional<std::tuple<TimerId, uint64_t, TimerCallback>> popDue(uint64_t limit);
+
+    /// Re-arms a periodic timer after it fired at @p fired_at; one-shot timers are dropped.
+    void rearm(TimerId id, uint64_t fired_at);
+
+    /// Moves every pending timer later by @p offset.
+    void shift(uint64_t offset);
+
+    bool empty() const { return order_.empty(); }
+
+private:
+    struct Timer {
+        uint64_t due;
+        uint64_t interval;
+        TimerCallback cb;
+    };
+
+    TimerId next_id_ = 1;
+    std::map<TimerId, Timer> timers_;
+    std::set<std::pair<uint64_t, TimerId>> order_;  // (due, id)
+};
+
+/**
+ * @class SimulationClock
+ * @brief Discrete-event clock that only moves when the simulator advances it.
+ *
+ * advanceTo() fires every timer due up to the target time, in order, with
+ * now() set to each timer's due time while it runs. Timers scheduled before
+ * the first advance are anchored to the first event time, so strategies can
+ * be started before replay begins. Time never moves backwards.
+ */
+class SimulationClock : public Clock {
+public:
+    uint64_t now() const override { return now_.load(std::memory_order_acquire); }
+    TimerId schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) override;
+    void cancel(TimerId id) override;
+
+    /**
+     * @brief Moves time forward to @p ts, firing every timer due on the way.
+     */
+    void advanceTo(uint64_t ts);
+
+    /**
+     * @brief Due time of the next pending timer, if any.
+     */
+    std::optional<uint64_t> nextTimerDue() const;
+
+private:
+    mutable std::mutex mutex_;
+    TimerSet timers_;
+    std::atomic<uint64_t> now_{0};
+    bool started_ = false;
+};
+
+/**
+ * @class RealTimeClock
+ * @brief Wall-clock time with timers fired from a background thread.
+ *
+ * The thread is started on the first schedule() call. cancel() waits for an
+ * in-flight call of the same timer unless invoked from that callback itself.
+ */
+class RealTimeClock : public Clock {
+public:
+    ~RealTimeClock() override;
+
+    uint64_t now() const override;
+    TimerId schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) override;
+    void cancel(TimerId id) override;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    TimerSet timers_;
+    TimerId firing_ = 0;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    void run();
+};
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file journal.hpp
+ * @brief Declares the append-only binary journal of engine inbound events and its reader.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @enum JournalEvent
+ * @brief Entry point through which an event reached the engine.
+ */
+enum class JournalEvent : uint8_t {
+    TICK,            ///< Simulator::onMarketData
+    ORDER,           ///< Simulator::onOrder
+    STRATEGY_ORDER,  ///< Strategy submitter, at arrival after order entry latency
+    CANCEL,          ///< Simulator::onCancel (only id and instrument are meaningful)
+    AUCTION,         ///< Simulator::startAuction (only instrument is meaningful)
+    UNCROSS,         ///< Simulator::uncross (instrument; price is the reference, NaN if none)
+    STRATEGY_CANCEL  ///< Strategy submitter cancel (zero-quantity resubmit), at arrival
+};
+
+/**
+ * @struct JournalRecord
+ * @brief One inbound event as stored in the journal.
+ */
+struct JournalRecord {
+    uint64_t sequence = 0;   ///< Position in the journal, from 0
+    uint64_t sim_time = 0;   ///< Engine clock when the event was applied
+    JournalEvent event = JournalEvent::TICK;
+    core::Order order;
+};
+
+/**
+ * @class JournalWriter
+ * @brief Appends records to a journal file from a background thread in batches.
+ *
+ * append() only encodes the record into an in-memory buffer; the writer
+ * thread swaps that buffer out and writes it whenever it reaches the batch
+ * size, the flush interval passes, or flush() is called. Records get
+ * consecutive sequence numbers in append order. Thread-safe.
+ *
+ * File layout: the 8-byte magic "TRDJRNL\0", a uint32 version, then one
+ * length-prefixed record after another, in host byte order.
+ */
+class JournalWriter {
+public:
+    /**
+     * @param path File to create (truncated if it exists)
+     * @param batch_bytes Buffered bytes that trigger a write
+     * @param flush_interval_us Longest time a record waits in memory
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit JournalWriter(const std::string& path,
+                           std::size_t batch_bytes = 64 * 1024,
+                           uint64_t flush_interval_us = 10'000);
+
+    /**
+     * @brief Writes everything still buffered, then stops the writer thread.
+     */
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    /**
+     * @brief Queues a record for writing.
+     * @return Sequence number of the record
+     */
+    uint64_t append(JournalEvent event, uint64_t sim_time, const core::Order& order);
+
+    /**
+     * @brief Blocks until every record appended so far has been written out.
+     */
+    void flush();
+
+private:
+    std::ofstream out_;
+    std::size_t batch_bytes_;
+    uint64_t flush_interval_us_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;     ///< Wakes the writer thread
+    std::condition_variable written_;  ///< Signals progress of durable_
+    std::vector<char> pending_;        ///< Encoded records not yet handed to the writer
+    uint64_t next_sequence_ = 0;
+    uint64_t durable_ = 0;             ///< Records written out so far
+    uint64_t flush_target_ = 0;        ///< Records a flush() caller is waiting for
+    bool stopping_ = false;
+    std::thread worker_;
+
+    void run();
+};
+
+/**
+ * @class JournalReader
+ * @brief Reads a journal written by JournalWriter, record by record.
+ */
+class JournalReader {
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or is not a journal
+     */
+    explicit JournalReader(const std::string& path);
+
+    /**
+     * @brief Reads the next record.
+     * @return False at the end of the journal, including a record cut short by a crash
+     */
+    bool next(JournalRecord& record);
+
+    /**
+     * @brief Skips ahead so that the next record read is the one numbered @p sequence.
+     *
+     * Only record lengths and sequence numbers are read on the way.
+     * @return False if the journal ends first
+     */
+    bool skipTo(uint64_t sequence);
+
+private:
+    std::ifstream in_;
+    std::vector<char> buffer_;
+};
+
+}
@@ -0,0 +1,90 @@
+/**
+ * @file latency_model.hpp
+ * @brief Declares latency models used to delay order entry and market data in simulated time.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace engine {
+
+/**
+ * @class LatencyModel
+ * @brief Produces one-way delays (microseconds) for messages on an instrument.
+ */
+class LatencyModel {
+public:
+    virtual ~LatencyModel() = default;
+
+    /**
+     * @brief Draws the delay for the next message.
+     * @param instrument Instrument the message refers to
+     * @return Delay in microseconds
+     */
+    virtual uint64_t sample(const std::string& instrument) = 0;
+};
+
+/**
+ * @class FixedLatency
+ * @brief Constant delay for every message.
+ */
+class FixedLatency : public LatencyModel {
+public:
+    explicit FixedLatency(uint64_t latency_us) : latency_us_(latency_us) {}
+
+    uint64_t sample(const std::string&) override { return latency_us_; }
+
+private:
+    uint64_t latency_us_;
+};
+
+/**
+ * @class LogNormalLatency
+ * @brief Delay drawn from a log-normal distribution, floored at a minimum.
+ *
+ * The generator is seeded explicitly so a replay draws the same delays every run.
+ */
+class LogNormalLatency : public LatencyModel {
+public:
+    /**
+     * @param median_us Median delay in microseconds
+     * @param sigma     Shape parameter (standard deviation of the log delay)
+     * @param min_us    Lower bound applied to every draw
+     * @param seed      Random seed
+     */
+    LogNormalLatency(double median_us, double sigma, uint64_t min_us = 0, uint64_t seed = 42);
+
+    uint64_t sample(const std::string&) override;
+
+private:
+    std::mt19937_64 rng_;
+    std::lognormal_distribution<double> dist_;
+    uint64_t min_us_;
+};
+
+/**
+ * @class PerInstrumentLatency
+ * @brief Routes each instrument to its own model, with a fallback for the rest.
+ */
+class PerInstrumentLatency : public LatencyModel {
+public:
+    explicit PerInstrumentLatency(std::unique_ptr<LatencyModel> fallback);
+
+    /**
+     * @brief Uses @p model for messages on @p instrument.
+     */
+    void set(const std::string& instrument, std::unique_ptr<LatencyModel> model);
+
+    uint64_t sample(const std::string& instrument) override;
+
+private:
+    std::unique_ptr<LatencyModel> fallback_;
+    std::unordered_map<std::string, std::unique_ptr<LatencyModel>> models_;
+};
+
+}
@@ -15,6 +15,7 @@
 #include <atomic>
 #include <thread>
 #include <functional>
+#include <vector>
 
 namespace engine {
 
@@ -50,6 +51,14 @@ public:
 
     void load();
 
+    /**
+     * @brief Parses the whole file into memory without invoking the callback.
+     *
+     * Lets one parse be shared read-only by many backtest runs.
+     * @return Orders in file order
+     */
+    std::vector<core::Order> loadOrders();
+
 private:
     std::string file_path_;
     std::atomic<bool> running_;
@@ -62,6 +71,11 @@ private:
      */
     void feedLoop(OrderCallback callback);
 
+    /**
+     * @brief Reads the whole file synchronously, passing each parsed order to @p sink.
+     */
+    void readFile(const OrderCallback& sink);
+
     /**
      * @brief Parses a CSV line into an Order.
      */
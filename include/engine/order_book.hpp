@@ -7,24 +7,245 @@
 
 #include "core/order.hpp"
 #include "core/trade.hpp"
+#include "core/seqlock.hpp"
 
 #include <map>
+#include <unordered_map>
+#include <optional>
 #include <deque>
 #include <vector>
 #include <mutex>
 #include <functional>
+#include <span>
 
 namespace engine {
 
 /**
- * @class OrderBook
+ * @enum SelfTradePrevention
+ * @brief Action taken when an incoming order would match a resting order of the same owner.
+ *
+ * Orders with owner_id 0 are anonymous and never trigger self-trade prevention.
+ */
+enum class SelfTradePrevention {
+    NONE,           ///< Allow self-trades
+    CANCEL_NEWEST,  ///< Cancel the rest of the incoming order
+    CANCEL_OLDEST,  ///< Cancel the resting order and keep matching
+    CANCEL_BOTH,    ///< Cancel both orders
+    DECREMENT       ///< Reduce both by the overlapping quantity without printing a trade
+};
+
+/**
+ * @enum TradingPhase
+ * @brief How a book treats incoming orders.
+ */
+enum class TradingPhase : uint8_t {
+    CONTINUOUS,  ///< Orders match on arrival
+    AUCTION      ///< Orders accumulate without matching until the uncross
+};
+
+/**
+ * @struct AuctionQuote
+ * @brief Equilibrium of a call auction: where and how much it would uncross.
+ */
+struct AuctionQuote {
+    double price;        ///< Uncrossing price
+    uint64_t volume;     ///< Quantity executed at that price
+    int64_t imbalance;   ///< Demand minus supply at that price (> 0 = buy surplus)
+};
+
+/**
+ * @struct PriceLevel
+ * @brief Resting orders at one price plus their aggregate displayed quantity.
+ *
+ * The aggregate is kept up to date on every insert, fill and cancel so depth
+ * can be read without walking the queue.
+ */
+struct PriceLevel {
+    std::deque<core::Order> orders; ///< Resting orders in queue priority
+    uint64_t quantity = 0;          ///< Sum of displayed quantity at this price
+
+    /// Number of orders resting at this price.
+    uint32_t orderCount() const { return static_cast<uint32_t>(orders.size()); }
+};
+
+/**
+ * @struct DepthLevel
+ * @brief Aggregated (market-by-price) view of one price level.
+ */
+struct DepthLevel {
+    double price;          ///< Level price
+    uint64_t quantity;     ///< Total displayed quantity
+    uint32_t order_count;  ///< Number of resting orders
+};
+
+/**
+ * @struct DepthSnapshot
+ * @brief Caller-owned buffer filled by depthSnapshot(); reuse it to avoid reallocating.
+ */
+struct DepthSnapshot {
+    std::vector<DepthLevel> bids; ///< Best (highest) bid first
+    std::vector<DepthLevel> asks; ///< Best (lowest) ask first
+};
+
+/**
+ * @struct TopOfBook
+ * @brief Best bid/offer published by the book for lock-free readers.
+ *
+ * A side with zero size is empty and its price is meaningless.
+ */
+struct TopOfBook {
+    double bid_price = 0.0;  ///< Best bid price
+    uint64_t bid_size = 0;   ///< Displayed quantity at the best bid
+    double ask_price = 0.0;  ///< Best ask price
+    uint64_t ask_size = 0;   ///< Displayed quantity at the best ask
+    uint64_t sequence = 0;   ///< Incremented every time the BBO changes
+
+    bool hasBid() const { return bid_size > 0; }
+    bool hasAsk() const { return ask_size > 0; }
+};
+
+/**
+ * @struct BookEvent
+ * @brief Change to one instrument's book, pushed to subscribed strategies.
+ *
+ * A coalesced event stands for several changes: @c top is the latest BBO and
+ * the trade fields add up every print since the strategy's previous event.
+ */
+struct BookEvent {
+    std::string instrument;
+    TopOfBook top;                 ///< BBO after the change
+    bool bbo_changed = false;      ///< Best bid or offer price/size moved
+    uint64_t traded_quantity = 0;  ///< Quantity printed (0 = no trade)
+    double last_trade_price = 0.0; ///< Price of the latest print
+    uint64_t timestamp = 0;        ///< Engine time of the latest change
+
+    /// Folds a later event for the same instrument into this one.
+    void merge(const BookEvent& later) {
+        top = later.top;
+        bbo_changed = bbo_changed || later.bbo_changed;
+        if (later.traded_quantity > 0) {
+            traded_quantity += later.traded_quantity;
+            last_trade_price = later.last_trade_price;
+        }
+        timestamp = later.timestamp;
+    }
+};
+
+/**
+ * @struct RestingOrder
+ * @brief Fixed-size image of one resting order, as stored in a checkpoint.
+ *
+ * Plain data with no pointers, so an array of them can be read straight out
+ * of a memory-mapped file.
+ */
+struct RestingOrder {
+    uint64_t id;
+    double price;
+    uint64_t timestamp;         ///< Queue time (of the current clip, for icebergs)
+    uint32_t quantity;          ///< Displayed quantity in the queue
+    uint32_t display_quantity;  ///< Iceberg clip size (0 = plain order)
+    uint32_t reserve;           ///< Hidden iceberg quantity behind the clip
+    uint32_t owner_id;
+    uint8_t side;               ///< core::Side
+    uint8_t market;             ///< 1 = market order waiting for the auction uncross
+    uint8_t padding[6];
+};
+static_assert(sizeof(RestingOrder) == 48, "RestingOrder is part of the checkpoint format");
+
+/**
+ * @struct BookState
+ * @brief Everything needed to rebuild a book: its counters and resting orders.
+ *
+ * Orders are bids best first, then asks best first, each level in queue
+ * priority, then any market orders waiting for an auction. The span does
+ * not own them.
+ */
+struct BookState {
+    uint64_t next_trade_id = 1;           ///< ID the next trade will get
+    uint64_t top_sequence = 0;            ///< TopOfBook::sequence of the current BBO
+    TradingPhase phase = TradingPhase::CONTINUOUS;
+    std::span<const RestingOrder> orders;
+};
+
+/**
+ * @struct FifoMatching
+ * @brief Price-time priority: each level is filled strictly in arrival order.
+ */
+struct FifoMatching {
+    static constexpr bool pro_rata = false;
+    static constexpr bool top_order_priority = false;
+};
+
+/**
+ * @struct ProRataMatching
+ * @brief Each level is shared in proportion to resting size; rounding leftovers go FIFO.
+ */
+struct ProRataMatching {
+    static constexpr bool pro_rata = true;
+    static constexpr bool top_order_priority = false;
+};
+
+/**
+ * @struct ProRataTopOrderMatching
+ * @brief The order at the front of a level is filled first, the remainder is pro-rata.
+ */
+struct ProRataTopOrderMatching {
+    static constexpr bool pro_rata = true;
+    static constexpr bool top_order_priority = true;
+};
+
+/**
+ * @struct SideTraits
+ * @brief Compile-time description of an incoming order's side.
+ *
+ * Lets the matching loop be written once and instantiated per side.
+ */
+template <core::Side S>
+struct SideTraits;
+
+template <>
+struct SideTraits<core::Side::BUY> {
+    /// Resting orders an incoming buy matches against.
+    template <typename Book>
+    static auto& opposite(Book& book) { return book.asks_; }
+
+    /// True if a buy limited at @p limit can trade at @p level.
+    static bool crosses(double limit, double level) { return limit >= level; }
+};
+
+template <>
+struct SideTraits<core::Side::SELL> {
+    /// Resting orders an incoming sell matches against.
+    template <typename Book>
+    static auto& opposite(Book& book) { return book.bids_; }
+
+    /// True if a sell limited at @p limit can trade at @p level.
+    static bool crosses(double limit, double level) { return limit <= level; }
+};
+
+/**
+ * @class BasicOrderBook
  * @brief Central limit order book for a single instrument.
  *
  * Supports order insertion, matching, cancellation, and trade generation.
+ * The allocation rule within a price level is fixed at compile time by
+ * @p MatchingPolicy (FifoMatching, ProRataMatching, ProRataTopOrderMatching).
+ *
+ * Iceberg orders (display_quantity > 0) rest with only their visible clip in
+ * the level queue. When a clip is fully filled the next clip is drawn from the
+ * hidden reserve and re-queued at the back of the same price level. Every
+ * query (best bid/ask, getOrders, printBook) reports displayed size only.
+ *
+ * In the AUCTION phase incoming orders are only collected, so the book may
+ * be crossed. uncross() then trades everything that crosses at the single
+ * price that executes the most volume and returns the book to continuous
+ * matching. Hidden iceberg quantity takes part in the auction in full.
  */
-class OrderBook {
+template <typename MatchingPolicy>
+class BasicOrderBook {
 public:
-    explicit OrderBook(const std::string& instrument);
+    explicit BasicOrderBook(const std::string& instrument,
+                            SelfTradePrevention stp = SelfTradePrevention::NONE);
 
     /**
      * @brief Adds a new order to the book and attempts to match it.
@@ -61,37 +282,259 @@ public:
      * @brief Returns the best ask order (lowest price sell), if any.
      */
     std::optional<core::Order> getBestAsk() const;
-    
+
+    /**
+     * @brief Returns the current best bid/offer without taking the book mutex.
+     *
+     * Bid and ask are always read as one consistent pair, published by the
+     * thread that last modified the book.
+     */
+    TopOfBook topOfBook() const { return top_of_book_.load(); }
+
+    /**
+     * @brief Copies the top @p levels price levels of each side into @p out.
+     *
+     * Reads the per-level aggregates directly, so the cost is proportional to
+     * the number of levels copied, not the number of resting orders.
+     * @param levels Maximum number of levels per side
+     * @param out Buffer to fill; previous contents are replaced
+     */
+    void depthSnapshot(std::size_t levels, DepthSnapshot& out) const;
+
+    /**
+     * @brief Displayed quantity resting at @p price on @p side (0 if there is no such level).
+     */
+    uint64_t levelQuantity(core::Side side, double price) const;
+
+    /**
+     * @brief Enters the auction phase: orders are collected without matching until uncross().
+     *
+     * Market orders wait for the uncross and are dropped if it leaves them unfilled.
+     */
+    void startAuction();
+
+    TradingPhase phase() const;
+
+    /**
+     * @brief Price and volume the auction would uncross at right now.
+     *
+     * The price maximizes executed volume; ties go to the smallest surplus,
+     * then to the highest price if the surplus is on the buy side at every
+     * tied price (lowest if it is on the sell side), then to the price
+     * closest to @p reference (the middle of the tied range if none).
+     * @return Nothing if the book does not cross
+     */
+    std::optional<AuctionQuote> indicativeUncross(std::optional<double> reference = std::nullopt) const;
+
+    /**
+     * @brief Ends the auction: executes every crossing order at the equilibrium price.
+     *
+     * Buy and sell orders are filled in price-time priority (waiting market
+     * orders first) whatever the MatchingPolicy, and self-trade prevention does
+     * not apply. Unfilled limit quantity stays in the book, which returns to
+     * continuous matching; unfilled market orders are dropped.
+     * @param timestamp Time stamped on the auction trades
+     * @param reference Tie-break price, e.g. the previous close
+     * @return Trades executed, all at the same price
+     */
+    std::vector<core::Trade> uncross(uint64_t timestamp, std::optional<double> reference = std::nullopt);
+
+    /**
+     * @brief Copies the book's resting orders into @p storage and describes them.
+     * @param storage Buffer for the orders; previous contents are replaced
+     * @return State whose orders point into @p storage
+     */
+    BookState saveState(std::vector<RestingOrder>& storage) const;
+
+    /**
+     * @brief Replaces the book's contents with a saved state.
+     *
+     * Orders are appended to their levels as given, without matching, so
+     * queue priority and iceberg reserves come back exactly as saved. Costs
+     * O(resting orders) when they are in saveState() order.
+     */
+    void restoreState(const BookState& state);
+
     void setTradeCallback(std::function<void(const core::Trade&)> cb);
 
+    /**
+     * @brief Sets how self-trades are handled for subsequent incoming orders.
+     */
+    void setSelfTradePrevention(SelfTradePrevention mode);
+
 private:
+    template <core::Side> friend struct SideTraits;
+
     std::string instrument_;
+    SelfTradePrevention stp_mode_;
     mutable std::mutex mutex_;
 
-    // Limit order storage: price -> deque of orders
-    std::map<double, std::deque<core::Order>, std::greater<>> bids_; // Buy side
-    std::map<double, std::deque<core::Order>> asks_;                 // Sell side
+    // Limit order storage: price -> level queue and aggregates
+    std::map<double, PriceLevel, std::greater<>> bids_; // Buy side
+    std::map<double, PriceLevel> asks_;                 // Sell side
 
     // All active orders by ID
     std::unordered_map<uint64_t, core::Order> orders_;  // All active orders by ID
 
+    // Hidden reserve of resting iceberg orders (order ID -> undisplayed quantity).
+    // Only consulted when a resting order carries a non-zero display_quantity.
+    std::unordered_map<uint64_t, uint32_t> iceberg_reserve_;
+
     // Trade ID tracker
     uint64_t next_trade_id_ = 1;
 
+    // Call auction state: market orders wait here, in arrival order, for the uncross
+    TradingPhase phase_ = TradingPhase::CONTINUOUS;
+    std::deque<core::Order> auction_buys_;
+    std::deque<core::Order> auction_sells_;
+
+    // Reused by pro-rata matching to collect orders emptied at a level
+    std::vector<core::Order> filled_scratch_;
+
+    // Last published BBO (writer side copy) and its lock-free publication
+    TopOfBook last_top_;
+    core::SeqLock<TopOfBook> top_of_book_;
+
     std::function<void(const core::Trade&)> trade_callback_;
 
     /**
      * @brief Matches a market or aggressive limit order against the opposite book.
-     * @param order Incoming order
-     * @return List of trades resulting from matching
+     *
+     * Walks levels from the best price until the order is filled or no
+     * longer crosses. One instantiation per side, no side branching inside.
+     * @param order Incoming order; its quantity is reduced by the executed amount
+     * @param trades Output list of trades resulting from matching
+     */
+    template <core::Side S>
+    void match(core::Order& order, std::vector<core::Trade>& trades);
+
+    /**
+     * @brief Fills a level in arrival order.
+     */
+    template <core::Side S>
+    void matchFifo(core::Order& order, double price, PriceLevel& level,
+                   std::vector<core::Trade>& trades);
+
+    /**
+     * @brief Shares a level across its resting orders in proportion to their size.
+     *
+     * Shares are rounded down; the leftover is handed out in arrival order.
+     * Fully filled orders are compacted out afterwards and iceberg clips
+     * replenished at the back of the level.
+     */
+    template <core::Side S>
+    void matchProRata(core::Order& order, double price, PriceLevel& level,
+                      std::vector<core::Trade>& trades);
+
+    /**
+     * @brief Trades (or self-trade-prevents) @p qty against one resting order.
+     *
+     * Keeps the level's aggregate quantity in step with the resting order.
      */
-    std::vector<core::Trade> match(const core::Order& order);
+    template <core::Side S>
+    void execute(core::Order& order, core::Order& resting, uint32_t qty, double price,
+                 PriceLevel& level, std::vector<core::Trade>& trades);
+
+    /**
+     * @brief Executes @p qty between the incoming and a resting order and records the trade.
+     */
+    template <core::Side S>
+    void fill(core::Order& order, core::Order& resting, uint32_t qty, double price,
+              std::vector<core::Trade>& trades);
+
+    /**
+     * @brief True if self-trade prevention applies between the incoming and resting order.
+     */
+    bool isSelfTrade(const core::Order& order, const core::Order& resting) const {
+        return stp_mode_ != SelfTradePrevention::NONE &&
+               order.owner_id != 0 && resting.owner_id == order.owner_id;
+    }
 
     /**
      * @brief Inserts a limit order into the correct side of the book.
+     *
+     * Iceberg orders are split into a visible clip and a hidden reserve.
      * @param order The limit order to insert
      */
     void insertLimitOrder(const core::Order& order);
+
+    /**
+     * @brief Removes a fully filled resting order from the front of its level.
+     *
+     * If the order is an iceberg with hidden reserve left, the next clip is
+     * appended to the back of the same level, losing time priority.
+     * @param level Level whose front order was fully filled
+     * @param ts Timestamp of the fill, used as the new clip's queue time
+     */
+    void popFilled(PriceLevel& level, uint64_t ts);
+
+    /**
+     * @brief Releases an order that has left its level with zero quantity.
+     *
+     * Appends the next iceberg clip to @p level if hidden reserve remains,
+     * otherwise forgets the order.
+     */
+    void releaseFilled(const core::Order& filled, PriceLevel& level, uint64_t ts);
+
+    /**
+     * @brief Removes a resting order from its level on one side of the book.
+     * @return True if the order was found at @p price
+     */
+    template <typename Levels>
+    bool eraseResting(Levels& levels, uint64_t order_id, double price);
+
+    /**
+     * @brief Drops a resting order without a fill (including any hidden reserve).
+     *
+     * The order is left in its queue with zero quantity for the caller to remove.
+     */
+    void cancelResting(core::Order& resting);
+
+    /**
+     * @brief Applies the self-trade prevention mode to a resting order.
+     *
+     * Called from inside the match loop when the incoming and resting orders
+     * share an owner. The incoming quantity drops to zero if it is cancelled;
+     * a resting order that is cancelled or decremented away is left with zero
+     * quantity for the caller to remove.
+     * @param order Incoming order
+     * @param resting Resting order with the same owner
+     * @param overlap Quantity that would otherwise have traded
+     */
+    void preventSelfTrade(core::Order& order, core::Order& resting, uint32_t overlap);
+
+    /**
+     * @brief Auction equilibrium from the cumulative demand and supply curves. Called with the mutex held.
+     */
+    std::optional<AuctionQuote> equilibrium(std::optional<double> reference) const;
+
+    /**
+     * @brief Quantity at a level including the hidden reserve of its icebergs.
+     */
+    uint64_t auctionQuantity(const PriceLevel& level) const;
+
+    /**
+     * @brief Records an auction trade between two orders and reduces both.
+     */
+    void auctionFill(core::Order& buy, core::Order& sell, uint32_t qty, double price, uint64_t ts,
+                     std::vector<core::Trade>& trades);
+
+    /**
+     * @brief BBO of the current levels, without a sequence number. Called with the mutex held.
+     */
+    TopOfBook currentTop() const;
+
+    /**
+     * @brief Publishes the BBO to readers if it changed. Called with the mutex held.
+     */
+    void publishTopOfBook();
 };
 
+/// Price-time priority book used by the simulator and strategies.
+using OrderBook = BasicOrderBook<FifoMatching>;
+
+extern template class BasicOrderBook<FifoMatching>;
+extern template class BasicOrderBook<ProRataMatching>;
+extern template class BasicOrderBook<ProRataTopOrderMatching>;
+
 }
\ No newline at end of file
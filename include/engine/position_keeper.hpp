@@ -0,0 +1,124 @@
+/**
+ * @file position_keeper.hpp
+ * @brief Declares the shared position keeper that marks every account's fills to the live mid.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+#include "core/seqlock.hpp"
+#include "core/trade.hpp"
+#include "engine/order_book.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace engine {
+
+/**
+ * @brief One account's holding in one instrument.
+ */
+struct Position {
+    int64_t quantity = 0;         ///< Signed filled quantity (long > 0)
+    double average_cost = 0.0;    ///< Average entry price of the open quantity
+    double realized_pnl = 0.0;    ///< PnL locked in by reducing or flipping the position
+    double mark_price = 0.0;      ///< Last mid (or fill price when the book had no mid)
+    double unrealized_pnl = 0.0;  ///< quantity * (mark_price - average_cost)
+    uint64_t fills = 0;           ///< Fills applied
+    uint64_t filled_quantity = 0; ///< Units traded in those fills
+};
+
+/**
+ * @brief An account's totals over every instrument.
+ */
+struct AccountPnL {
+    double realized_pnl = 0.0;
+    double unrealized_pnl = 0.0;
+    double peak_pnl = 0.0;      ///< Highest total PnL seen at a fill or mark
+    double max_drawdown = 0.0;  ///< Largest fall of total PnL from its peak
+    uint64_t fills = 0;
+
+    double totalPnL() const { return realized_pnl + unrealized_pnl; }
+};
+
+/**
+ * @class PositionKeeper
+ * @brief Central positions and mark-to-market PnL, attributed by trade owner IDs.
+ *
+ * Instruments and accounts are registered up front, as with RiskGateway. Each
+ * fill updates the buyer's and seller's position with average-cost
+ * accounting and adjusts their account totals by the change, so onFill() is
+ * O(1). mark() re-prices one instrument at its book's mid for every account,
+ * which also samples each account's drawdown.
+ *
+ * Prices and PnL are in each instrument's quote currency, and account totals
+ * add instruments up without conversion: they are only meaningful when all
+ * instruments share one quote currency (e.g. ETH-USD and BTC-USD, not ETH-BTC).
+ *
+ * Positions and totals are published through seqlocks: any thread may read
+ * them without locking, but onFill() and mark() need a single writer at a
+ * time (Simulator calls both under its own lock).
+ */
+class PositionKeeper {
+public:
+    /**
+     * @brief Registers an instrument. Call before addAccount().
+     * @param book Book whose mid marks open positions; nullptr marks at the last fill price
+     * @throws std::logic_error once accounts exist
+     */
+    void addInstrument(const std::string& instrument, const OrderBook* book = nullptr);
+
+    /**
+     * @brief Registers an owner ID (see Simulator::makeSubmitter) to keep positions for.
+     * @throws std::invalid_argument if the account already exists
+     */
+    void addAccount(uint32_t owner_id);
+
+    /**
+     * @brief Applies a trade to the accounts on either side of it; other owners are ignored.
+     */
+    void onFill(const core::Trade& trade);
+
+    /**
+     * @brief Re-marks every account's position in @p instrument to the book's current mid.
+     *
+     * Does nothing while the book lacks either side.
+     */
+    void mark(const std::string& instrument);
+
+    /**
+     * @brief Position of an account in an instrument (empty if either is unknown).
+     */
+    Position position(uint32_t owner_id, const std::string& instrument) const;
+
+    /**
+     * @brief Totals of an account (empty if unknown), summed across instruments without
+     * quote-currency conversion.
+     */
+    AccountPnL pnl(uint32_t owner_id) const;
+
+private:
+    struct Instrument {
+        std::size_t slot;
+        const OrderBook* book;
+    };
+
+    struct Account {
+        std::unique_ptr<Position[]> positions;  ///< Writer's working copies, one per instrument slot
+        std::unique_ptr<core::SeqLock<Position>[]> published;
+        AccountPnL totals;  ///< Writer's working copy
+        core::SeqLock<AccountPnL> published_totals;
+    };
+
+    std::unordered_map<std::string, Instrument> instruments_;
+    std::unordered_map<uint32_t, std::unique_ptr<Account>> accounts_;
+
+    Account* account(uint32_t owner_id) const;
+    void apply(Account& account, std::size_t slot, int64_t quantity, double price, double mark);
+    void remark(Account& account, std::size_t slot, double mark);
+    void publish(Account& account, std::size_t slot, double realized_delta, double unrealized_delta);
+};
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file queue_fill_model.hpp
+ * @brief Declares the queue-position fill model for passive strategy orders.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+#include "core/trade.hpp"
+#include "engine/order_book.hpp"
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @class QueueFillModel
+ * @brief Fills resting strategy orders from historical flow using an estimated queue position.
+ *
+ * Strategy orders tracked here are shadows: they never enter the historical
+ * book, so they have no market impact. Each remembers how much historical
+ * displayed quantity was ahead of it at its price when it arrived.
+ * - Historical trades at the order's price consume that quantity first; the
+ *   excess fills the shadows at the level in arrival order.
+ * - Trades at worse prices, and historical orders that rest at or through a
+ *   shadow's price, fill it immediately (nothing historical was ahead).
+ * - Cancels of historical orders that arrived before a shadow move it up.
+ *
+ * Shadows are indexed per instrument, side and price, so each event only
+ * touches the levels it crosses.
+ */
+class QueueFillModel {
+public:
+    /// Fill trade IDs start here, above any ID a book hands out, so they never collide.
+    static constexpr uint64_t fill_id_base = uint64_t{1} << 63;
+
+    /**
+     * @brief Starts tracking a passive order.
+     * @param order Resting strategy order (limit price, remaining quantity)
+     * @param queue_ahead Historical displayed quantity at the same price and side
+     * @param arrival Time the order reached the venue
+     */
+    void add(const core::Order& order, uint64_t queue_ahead, uint64_t arrival);
+
+    /**
+     * @brief Stops tracking an order.
+     * @return True if the order was still resting
+     */
+    bool cancel(uint64_t order_id);
+
+    /**
+     * @brief Applies a historical trade; appends resulting strategy fills to @p fills.
+     */
+    void onTrade(const core::Trade& trade, std::vector<core::Trade>& fills);
+
+    /**
+     * @brief Applies a historical limit order that came to rest with @p order.quantity left.
+     *
+     * Shadows on the other side at or through its price would have traded with it.
+     */
+    void onRest(const core::Order& order, std::vector<core::Trade>& fills);
+
+    /**
+     * @brief Applies the cancel of a historical resting order.
+     */
+    void onCancel(const core::Order& canceled);
+
+    /**
+     * @brief Estimated historical quantity still ahead of an order, if it is tracked.
+     */
+    std::optional<uint64_t> queueAhead(uint64_t order_id) const;
+
+    /// Number of orders being tracked.
+    std::size_t size() const { return index_.size(); }
+
+private:
+    struct ShadowOrder {
+        core::Order order;  ///< Remaining quantity is order.quantity
+        uint64_t ahead;     ///< Historical quantity still in front
+        uint64_t arrival;   ///< Venue arrival time
+    };
+
+    using ShadowLevel = std::deque<ShadowOrder>;
+
+    // Shadow orders for one instrument, laid out like the book so SideTraits applies.
+    struct Book {
+        std::map<double, ShadowLevel, std::greater<>> bids_;
+        std::map<double, ShadowLevel> asks_;
+    };
+
+    struct Location {
+        Book* book;
+        core::Side side;
+        double price;
+    };
+
+    std::unordered_map<std::string, Book> books_;
+    std::unordered_map<uint64_t, Location> index_;
+    uint64_t next_fill_id_ = fill_id_base;
+
+    /**
+     * @brief Fills shadows crossed by aggressive flow of side @p S at @p price.
+     * @param volume Aggressive quantity available to the shadows
+     * @param at_price_queued If true, shadows exactly at @p price wait behind their queue
+     */
+    template <core::Side S>
+    void sweep(Book& book, const std::string& instrument, uint64_t aggressor_id, double price,
+               uint64_t volume, bool at_price_queued, uint64_t ts, std::vector<core::Trade>& fills);
+
+    template <typename Levels>
+    static auto findLevel(Levels& levels, double price) -> decltype(&levels.begin()->second) {
+        auto it = levels.find(price);
+        return it == levels.end() ? nullptr : &it->second;
+    }
+};
+
+}
@@ -0,0 +1,134 @@
+/**
+ * @file risk_gateway.hpp
+ * @brief Declares the pre-trade risk gateway that checks strategy orders before they reach a book.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+#include "core/trade.hpp"
+#include "engine/order_book.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Why the risk gateway refused an order.
+ */
+enum class RejectReason : uint8_t {
+    NONE,                ///< Accepted
+    KILL_SWITCH,         ///< Trading halted for everyone or for this account
+    UNKNOWN_ACCOUNT,     ///< No limits registered for the order's owner
+    UNKNOWN_INSTRUMENT,  ///< Instrument not registered with the gateway
+    ORDER_SIZE,          ///< Quantity above the per-order maximum
+    PRICE_COLLAR,        ///< Limit price too far from the book's mid
+    POSITION_LIMIT,      ///< Filled position plus the order would exceed the limit
+    NOTIONAL_LIMIT,      ///< Position value after the order would exceed the limit
+    RATE_LIMIT           ///< Too many orders in the current second
+};
+
+/// Short name of a reject reason for logs.
+const char* rejectReasonName(RejectReason reason);
+
+/**
+ * @brief Per-account limits; a zero leaves that check off.
+ */
+struct RiskLimits {
+    uint32_t max_order_quantity = 0;     ///< Largest quantity of a single order
+    double price_collar = 0.0;           ///< Largest fractional distance of a limit price from the mid
+    int64_t max_position = 0;            ///< Largest absolute position per instrument
+    double max_notional = 0.0;           ///< Largest absolute position value per instrument
+    uint32_t max_orders_per_second = 0;  ///< Orders (including cancels) per second of engine time
+};
+
+/**
+ * @class RiskGateway
+ * @brief Central pre-trade checks on the strategy submit path.
+ *
+ * Instruments and accounts are registered up front; afterwards check() and
+ * onFill() only read the fixed tables and update per-account atomics, so they
+ * take no locks and cost a hash of the instrument name plus a few relaxed
+ * atomic operations. Collars read the book's seqlock-published BBO.
+ *
+ * Position checks use the filled position (from onFill) plus the order being
+ * checked; working orders are not reserved. Cancels (zero quantity) are always
+ * accepted so a halted strategy can still pull its quotes. A market order is
+ * valued at the touch it would take, or the other side if that one is empty;
+ * with a notional limit set, one that cannot be valued at all is refused. The rate throttle
+ * counts orders per whole second of the time passed to check(), so a replay
+ * throttles the same way every run.
+ */
+class RiskGateway {
+public:
+    /**
+     * @brief Registers an instrument. Call before addAccount().
+     * @param book Book whose BBO centers the price collar; nullptr disables the collar here
+     * @throws std::logic_error once accounts exist
+     */
+    void addInstrument(const std::string& instrument, const OrderBook* book = nullptr);
+
+    /**
+     * @brief Registers an owner ID (see Simulator::makeSubmitter) with its limits.
+     * @throws std::invalid_argument if the account already exists
+     */
+    void addAccount(uint32_t owner_id, const RiskLimits& limits);
+
+    /**
+     * @brief Checks an order about to be submitted and counts it against the rate limit.
+     * @param now_us Engine time of the submission
+     */
+    RejectReason check(const core::Order& order, uint64_t now_us);
+
+    /**
+     * @brief Updates the positions of the accounts on either side of a trade.
+     */
+    void onFill(const core::Trade& trade);
+
+    /// Halts new orders from every account.
+    void kill() { killed_.store(true, std::memory_order_release); }
+    void resume() { killed_.store(false, std::memory_order_release); }
+
+    /// Halts or resumes new orders from one account.
+    void kill(uint32_t owner_id);
+    void resume(uint32_t owner_id);
+
+    /**
+     * @brief Filled position of an account in an instrument (0 if either is unknown).
+     */
+    int64_t position(uint32_t owner_id, const std::string& instrument) const;
+
+    /**
+     * @brief Orders refused for an account so far.
+     */
+    uint64_t rejectedCount(uint32_t owner_id) const;
+
+private:
+    struct Instrument {
+        std::size_t slot;
+        const OrderBook* book;
+    };
+
+    struct Account {
+        RiskLimits limits;
+        std::atomic<bool> killed{false};
+        std::atomic<uint64_t> rate_window{0};  ///< Second the rate count belongs to
+        std::atomic<uint32_t> rate_count{0};
+        std::atomic<uint64_t> rejected{0};
+        std::unique_ptr<std::atomic<int64_t>[]> positions;  ///< One per instrument slot
+    };
+
+    std::atomic<bool> killed_{false};
+    std::unordered_map<std::string, Instrument> instruments_;
+    std::unordered_map<uint32_t, std::unique_ptr<Account>> accounts_;
+
+    Account* account(uint32_t owner_id) const;
+    RejectReason evaluate(Account& account, const core::Order& order, uint64_t now_us) const;
+};
+
+}
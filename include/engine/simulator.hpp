@@ -8,26 +8,99 @@
 #include "core/order.hpp"
 #include "core/trade.hpp"
 #include "engine/order_book.hpp"
+#include "engine/clock.hpp"
+#include "engine/journal.hpp"
+#include "engine/latency_model.hpp"
+#include "engine/position_keeper.hpp"
+#include "engine/queue_fill_model.hpp"
+#include "engine/risk_gateway.hpp"
+#include "engine/thread_pool.hpp"
 #include "strategy/strategy.hpp"
 
+#include <atomic>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 
 namespace engine {
 
 /**
  * @class Simulator
  * @brief Handles market data replay, order matching, and trade distribution.
+ *
+ * The simulator owns the clock shared with its strategies. By default this is
+ * a SimulationClock advanced to each market data timestamp, so strategy
+ * timers fire in simulated time and a replay is reproducible run to run.
+ *
+ * In simulated time, optional latency models delay strategy orders on their
+ * way to the book and market data / fills on their way to the strategies.
+ * Delayed messages are one-shot clock timers, and each channel keeps its
+ * messages in send order even when sampled delays would reorder them.
+ *
+ * With queue-position fills enabled, passive strategy orders are kept out of
+ * the historical books and filled by a QueueFillModel from the historical
+ * flow, so they wait behind the displayed liquidity ahead of them.
+ *
+ * In live runs an optional ThreadPool hosts the strategies: each gets its own
+ * Strand, and every strategy entry point (start/stop, market data, trades and
+ * timer callbacks) runs on it, so a strategy never runs on two threads at once.
+ *
+ * Strategies that subscribed to book events get a BookEvent whenever an order
+ * moves an instrument's BBO or prints trades. Events reach a strategy in
+ * order and never nest: ones raised while it handles an event (for example
+ * by its own orders) wait until it returns, and are merged per instrument if
+ * the strategy asked for coalescing. In simulated time they are delivered
+ * before the next tick is processed; with an executor, on the strategy's strand.
+ *
+ * Strategies that subscribed to instruments (Strategy::subscribe) are placed
+ * on per-instrument dispatch lists at registration, so an event only reaches
+ * the strategies interested in its instrument and event type.
+ *
+ * With a journal attached, every event that reaches a book (ticks, direct
+ * orders, strategy orders on arrival, cancels, auction phases) is recorded with the engine
+ * time it was applied at. replay() feeds such records back to rebuild the
+ * same books and trades.
+ *
+ * With a RiskGateway attached, every strategy order is checked on the submit
+ * path before any latency or matching; refused orders never reach a book or
+ * the journal, and the strategy registered under the order's owner ID hears
+ * about them through Strategy::onOrderRejected, delivered like a book event
+ * (never inside the callback that submitted the order). Every trade updates
+ * the gateway's positions.
+ *
+ * An attached PositionKeeper sees every trade as well, and is re-marked
+ * whenever a book's BBO moves, so its PnL follows the live mid.
+ *
+ * saveCheckpoint() writes the books, strategy state and engine time together
+ * with the journal position; restoreCheckpoint() loads them back without
+ * re-matching, so a replay can resume from the checkpoint instead of the
+ * start of the journal.
  */
 class Simulator {
 public:
+    /**
+     * @brief Constructs a simulator.
+     * @param clock Clock for live runs; nullptr (default) uses a SimulationClock
+     * @param executor Pool hosting strategy callbacks in live runs; ignored in
+     *                 simulated time, where everything runs on the caller's thread
+     */
+    explicit Simulator(std::shared_ptr<Clock> clock = nullptr,
+                       std::shared_ptr<ThreadPool> executor = nullptr);
+
     /**
      * @brief Registers a strategy to receive trades and market updates.
+     *
+     * Also subscribes it to book events if it asked for them
+     * (Strategy::subscribeBookEvents).
      * @param strategy Pointer to a Strategy instance
+     * @param owner_id Owner ID of its submitter (makeSubmitter), to route risk
+     *                 rejects back to it; 0 (default) if it has none
      */
-    void registerStrategy(std::shared_ptr<strategy::Strategy> strategy);
+    void registerStrategy(std::shared_ptr<strategy::Strategy> strategy, uint32_t owner_id = 0);
 
     /**
      * @brief Feeds an order into the simulator (from market data or strategy).
@@ -35,6 +108,142 @@ public:
      */
     void onOrder(const core::Order& order);
 
+    /**
+     * @brief Feeds a market data tick: advances simulated time, routes the
+     * order to its book, then forwards it to every strategy.
+     * @param order Tick from the market data feed
+     */
+    void onMarketData(const core::Order& order);
+
+    /**
+     * @brief Feeds a market data cancel of a resting historical order.
+     * @param instrument Instrument of the order
+     * @param order_id ID of the order to remove
+     */
+    void onCancel(const std::string& instrument, uint64_t order_id);
+
+    /**
+     * @brief Starts the call auction of an instrument's book (OrderBook::startAuction).
+     */
+    void startAuction(const std::string& instrument);
+
+    /**
+     * @brief Uncrosses an instrument's auction and publishes its trades like any others.
+     * @param reference Tie-break price for OrderBook::uncross
+     */
+    void uncross(const std::string& instrument, std::optional<double> reference = std::nullopt);
+
+    /**
+     * @brief Returns the book for an instrument, creating it if needed.
+     */
+    OrderBook& getBook(const std::string& instrument);
+
+    /**
+     * @brief Clock shared with registered strategies.
+     */
+    Clock& clock() { return *clock_; }
+
+    /**
+     * @brief Returns a submit callback that stamps orders with an owner ID before routing them.
+     *
+     * Strategies sharing the simulator should each get a distinct owner ID so
+     * that self-trade prevention can recognise their own resting orders.
+     * @param owner_id Non-zero participant ID
+     */
+    strategy::SubmitOrderCallback makeSubmitter(uint32_t owner_id);
+
+    /**
+     * @brief Sets the self-trade prevention mode for all current and future books.
+     */
+    void setSelfTradePrevention(SelfTradePrevention mode);
+
+    /**
+     * @brief Delays strategy orders between submission and arrival at the book.
+     *
+     * Only applies in simulated time. Orders from one owner arrive in the order
+     * they were submitted. nullptr (default) routes orders immediately.
+     */
+    void setOrderEntryLatency(std::unique_ptr<LatencyModel> model);
+
+    /**
+     * @brief Delays delivery of market data ticks and fills to strategies.
+     *
+     * Only applies in simulated time; the book still sees each tick at its own
+     * timestamp. nullptr (default) delivers immediately.
+     */
+    void setMarketDataLatency(std::unique_ptr<LatencyModel> model);
+
+    /**
+     * @brief Switches passive strategy orders to queue-position-aware fills.
+     *
+     * When enabled, strategy orders first take any liquidity they cross in
+     * the book; the passive remainder is tracked by a QueueFillModel instead
+     * of resting in the book. Resubmitting an order ID with zero quantity
+     * cancels it. Default is disabled: strategy orders rest in the book.
+     */
+    void setQueuePositionFills(bool enabled);
+
+    /**
+     * @brief Checks strategy orders against @p gateway before routing them; nullptr (default) checks nothing.
+     *
+     * Safe to call while strategies submit; each order is checked against the
+     * gateway set when it was submitted. The gateway's instruments and
+     * accounts must already be registered.
+     */
+    void setRiskGateway(std::shared_ptr<RiskGateway> gateway);
+
+    /**
+     * @brief Keeps positions and PnL in @p keeper from now on; nullptr (default) keeps none.
+     *
+     * The keeper's instruments and accounts must already be registered.
+     */
+    void setPositionKeeper(std::shared_ptr<PositionKeeper> keeper);
+
+    /**
+     * @brief Records every inbound event to @p journal from now on; nullptr stops recording.
+     */
+    void setJournal(std::shared_ptr<JournalWriter> journal);
+
+    /**
+     * @brief Applies one journaled event as it was originally applied.
+     *
+     * Replaying a whole journal into a simulator configured like the original
+     * one (self-trade prevention, queue fills) reproduces its books and
+     * trades. Strategy orders come from the journal, so register only
+     * strategies that do not trade.
+     */
+    void replay(const JournalRecord& record);
+
+    /**
+     * @brief Sequence number of the next journal record recorded or replayed.
+     */
+    uint64_t journalPosition() const { return journal_position_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Writes every book, each strategy's saved state, the engine time
+     * and the journal position to a checkpoint file.
+     *
+     * Take it between events: orders and market data still in flight through
+     * a latency model, and queue-position shadow orders, are not included.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveCheckpoint(const std::string& path);
+
+    /**
+     * @brief Loads a checkpoint written by saveCheckpoint(). Call before start().
+     *
+     * Books are rebuilt in O(resting orders) straight from the mapped file.
+     * The registered strategies must be the ones checkpointed, in the same order.
+     * @return Journal sequence to resume replaying from (see JournalReader::skipTo)
+     * @throws std::runtime_error if the file is not a checkpoint or the strategies differ
+     */
+    uint64_t restoreCheckpoint(const std::string& path);
+
+    /**
+     * @brief Queue-position model holding passive strategy orders.
+     */
+    const QueueFillModel& queueFillModel() const { return queue_model_; }
+
     /**
      * @brief Starts all registered strategies.
      */
@@ -46,9 +255,148 @@ public:
     void stop();
 
 private:
+    std::shared_ptr<Clock> clock_; ///< Time source handed to strategies
+    SimulationClock* sim_clock_ = nullptr; ///< Set when replaying in simulated time
     std::unordered_map<std::string, engine::OrderBook> books_; ///< Order books per instrument
+    std::shared_ptr<ThreadPool> executor_; ///< Hosts strategy callbacks in live runs
     std::vector<std::shared_ptr<strategy::Strategy>> strategies_; ///< All trading strategies
+    std::vector<std::shared_ptr<Strand>> strands_; ///< Per-strategy strand when executor_ is set
+    SelfTradePrevention stp_mode_ = SelfTradePrevention::NONE; ///< Applied to every book
+    std::unique_ptr<LatencyModel> order_latency_; ///< Strategy -> book delay
+    std::unique_ptr<LatencyModel> md_latency_; ///< Feed/book -> strategy delay
+    std::unordered_map<uint32_t, uint64_t> last_order_arrival_; ///< Per-owner arrival time, keeps FIFO
+    uint64_t last_md_arrival_ = 0; ///< Latest scheduled market data delivery
+    bool queue_fills_ = false; ///< Passive strategy orders go to queue_model_
+    QueueFillModel queue_model_; ///< Shadow strategy orders and their queue positions
+    std::shared_ptr<JournalWriter> journal_; ///< Inbound event recorder, if any
+    std::atomic<uint64_t> journal_position_{0}; ///< Next journal sequence recorded or replayed
+    std::shared_ptr<RiskGateway> risk_; ///< Pre-trade checks on strategy orders, if any
+    std::shared_ptr<PositionKeeper> positions_; ///< Shared positions and PnL, if any
+    std::unordered_map<uint32_t, std::size_t> owners_; ///< Owner ID -> strategies_ index, fixed once registered
     std::mutex mutex_; ///< Protect shared state
+
+    struct BookSubscriber {
+        std::size_t index;              ///< Position in strategies_ / strands_
+        bool coalesce;                  ///< Merge waiting events per instrument
+        std::deque<BookEvent> pending;  ///< Events not yet delivered
+        bool draining = false;          ///< Delivery in progress or queued on the strand
+    };
+    std::vector<BookSubscriber> book_subscribers_; ///< Fixed once strategies are registered
+    std::mutex events_mutex_; ///< Protects subscriber queues
+
+    struct Rejection {
+        std::size_t index;  ///< Position in strategies_
+        core::Order order;
+        RejectReason reason;
+    };
+    std::deque<Rejection> pending_rejects_; ///< Risk rejects not yet delivered (no executor), under events_mutex_
+
+    /**
+     * @brief Strategies interested in one instrument, in registration order.
+     */
+    struct Route {
+        std::vector<std::size_t> market_data;  ///< Indices into strategies_
+        std::vector<std::size_t> trades;       ///< Indices into strategies_
+        std::vector<std::size_t> book;         ///< Indices into book_subscribers_
+    };
+    std::unordered_map<std::string, Route> routes_; ///< Fixed once strategies are registered
+    Route any_route_; ///< Strategies without instrument subscriptions
+
+    /**
+     * @brief Dispatch lists for an instrument (any_route_ if nobody subscribed to it).
+     */
+    const Route& routeFor(const std::string& instrument) const;
+
+    /**
+     * @brief Delay until a message sent now arrives, never before @p last_arrival.
+     */
+    uint64_t arrivalDelay(LatencyModel& model, const std::string& instrument, uint64_t& last_arrival);
+
+    /**
+     * @brief Book for an instrument, created on first use. Called with mutex_ held.
+     */
+    OrderBook& bookFor(const std::string& instrument);
+
+    /**
+     * @brief Journals and matches an order against its book.
+     * @param source Entry point recorded in the journal
+     * @return The book change to publish, if any
+     */
+    std::optional<BookEvent> applyOrder(const core::Order& order, JournalEvent source);
+
+    /**
+     * @brief Appends an inbound event to the journal, if any. Called with mutex_ held
+     * so the journal order is the order events reach the books.
+     */
+    void record(JournalEvent event, const core::Order& order);
+
+    /**
+     * @brief Book change between two BBO samples, or nothing if unchanged
+     * and nothing traded (or nobody subscribed). Called with mutex_ held.
+     */
+    std::optional<BookEvent> bookChange(const std::string& instrument, const TopOfBook& before,
+                                        const TopOfBook& after, const std::vector<core::Trade>& trades) const;
+
+    /**
+     * @brief Re-marks the position keeper's @p instrument if the BBO moved. Called with mutex_ held.
+     */
+    void markPositions(const std::string& instrument, const TopOfBook& before, const TopOfBook& after);
+
+    /**
+     * @brief Queues a book event for every subscriber, after market data latency.
+     */
+    void publishBookEvent(const BookEvent& event);
+    void deliverBookEvent(const BookEvent& event);
+
+    /**
+     * @brief Hands one subscriber its queued events until none are left.
+     * @return False if nothing was delivered or delivery is already running
+     */
+    bool drainBookEvents(std::size_t subscriber);
+
+    /**
+     * @brief Delivers queued book events and risk rejects on the calling thread (no executor).
+     */
+    void flushBookEvents();
+
+    /**
+     * @brief Queues (or posts to the strand) a risk reject for the order's owner.
+     */
+    void rejectOrder(const core::Order& order, RejectReason reason);
+
+    /**
+     * @brief Hands out queued risk rejects until none are left.
+     * @return False if nothing was delivered
+     */
+    bool drainRejections();
+
+    /**
+     * @brief Routes an order from a strategy submitter to the book or the queue model.
+     *
+     * A zero quantity cancels the strategy's order with that ID (cancelStrategyOrder).
+     */
+    void routeStrategyOrder(const core::Order& order);
+
+    /**
+     * @brief Cancels a strategy's resting or shadow order, journaled as STRATEGY_CANCEL.
+     *
+     * Like routeStrategyOrder, only queues the resulting book event.
+     */
+    void cancelStrategyOrder(const core::Order& order);
+
+    /**
+     * @brief Publishes book trades and any queue-model fills they cause. Called with mutex_ held.
+     */
+    void processTrades(const std::vector<core::Trade>& trades);
+
+    void publishTrade(const core::Trade& trade);
+    void publishMarketData(const core::Order& order);
+
+    /**
+     * @brief Hands an event to every strategy, directly or through its strand.
+     */
+    void deliverTrade(const core::Trade& trade);
+    void deliverMarketData(const core::Order& order);
 };
 
 }  
\ No newline at end of file
@@ -0,0 +1,142 @@
+/**
+ * @file static_host.hpp
+ * @brief Declares a compile-time strategy host with no virtual calls on the tick path.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+#include "core/trade.hpp"
+#include "engine/order_book.hpp"
+
+#include <concepts>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Anything strategy orders can be handed to: `sink(order)`.
+ */
+template <typename Sink>
+concept OrderSink = requires(Sink& sink, const core::Order& order) {
+    sink(order);
+};
+
+/**
+ * @brief Strategy driven by a StaticHost; it submits orders straight to the sink it is given.
+ */
+template <typename S, typename Sink>
+concept StaticStrategy = OrderSink<Sink> &&
+    requires(S& strategy, Sink& sink, const core::Order& order, const core::Trade& trade) {
+        strategy.onMarketData(order, sink);
+        strategy.onTrade(trade, sink);
+    };
+
+/**
+ * @class BookSink
+ * @brief Order sink that matches orders in its own books and keeps the trades for the host.
+ *
+ * Books are created on first use per instrument, like Simulator's.
+ */
+template <typename MatchingPolicy = FifoMatching>
+class BookSink {
+public:
+    using Book = BasicOrderBook<MatchingPolicy>;
+
+    explicit BookSink(SelfTradePrevention stp = SelfTradePrevention::CANCEL_NEWEST) : stp_mode_(stp) {}
+
+    /**
+     * @brief Matches an order; its trades wait in trades() until the host drains them.
+     */
+    void operator()(const core::Order& order) {
+        auto trades = book(order.instrument).addOrder(order);
+        trades_.insert(trades_.end(), trades.begin(), trades.end());
+    }
+
+    /**
+     * @brief Returns the book for an instrument, creating it if needed.
+     */
+    Book& book(const std::string& instrument) {
+        return books_.try_emplace(instrument, instrument, stp_mode_).first->second;
+    }
+
+    /// Trades not yet handed to the strategy; grows while they are delivered.
+    std::vector<core::Trade>& trades() { return trades_; }
+
+private:
+    SelfTradePrevention stp_mode_;
+    std::unordered_map<std::string, Book> books_;
+    std::vector<core::Trade> trades_;
+};
+
+/**
+ * @class StaticHost
+ * @brief Runs one strategy type against one sink type, both fixed at compile time.
+ *
+ * The counterpart of Simulator for a fixed deployment: there is no Strategy
+ * base class, shared_ptr or std::function between a tick and the orders it
+ * causes, so the whole tick -> decision -> order path can be inlined.
+ * Simulator and the virtual Strategy interface remain for configurations
+ * chosen at run time.
+ *
+ * If the sink has trades() (e.g. BookSink), ticks are matched in it first
+ * and every resulting trade, including those caused by orders the strategy
+ * submits while handling a trade, is delivered to onTrade in order.
+ */
+template <typename StrategyT, typename SinkT>
+    requires StaticStrategy<StrategyT, SinkT>
+class StaticHost {
+public:
+    /**
+     * @param sink Order sink the strategy submits to
+     * @param args Forwarded to the StrategyT constructor
+     */
+    template <typename... Args>
+    explicit StaticHost(SinkT sink, Args&&... args)
+        : sink_(std::move(sink)), strategy_(std::forward<Args>(args)...) {}
+
+    /**
+     * @brief Feeds a market data tick: into the sink's book (if any), then to the strategy.
+     */
+    void onMarketData(const core::Order& order) {
+        if constexpr (matches_) {
+            sink_(order);
+            deliverTrades();
+        }
+        strategy_.onMarketData(order, sink_);
+        if constexpr (matches_) {
+            deliverTrades();
+        }
+    }
+
+    /**
+     * @brief Reports an execution from outside the sink (e.g. an exchange fill).
+     */
+    void onTrade(const core::Trade& trade) { strategy_.onTrade(trade, sink_); }
+
+    StrategyT& strategy() { return strategy_; }
+    SinkT& sink() { return sink_; }
+
+private:
+    static constexpr bool matches_ = requires(SinkT& sink) {
+        { sink.trades() } -> std::same_as<std::vector<core::Trade>&>;
+    };
+
+    SinkT sink_;
+    StrategyT strategy_;
+
+    void deliverTrades() {
+        auto& trades = sink_.trades();
+        // onTrade may submit and append more trades, so index rather than iterate
+        for (std::size_t i = 0; i < trades.size(); ++i) {
+            core::Trade trade = trades[i];
+            strategy_.onTrade(trade, sink_);
+        }
+        trades.clear();
+    }
+};
+
+}
@@ -0,0 +1,104 @@
+/**
+ * @file sweep_runner.hpp
+ * @brief Declares the parallel parameter-sweep backtest runner.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+#include "engine/simulator.hpp"
+#include "strategy/strategy.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @struct SweepParams
+ * @brief One point of the parameter grid.
+ */
+struct SweepParams {
+    double spread;  ///< Arbitrage spread threshold
+    int size;       ///< Order size
+    double risk;    ///< Max loss before the strategy stops
+};
+
+/**
+ * @struct SweepResult
+ * @brief Summary metrics of one backtest run.
+ */
+struct SweepResult {
+    SweepParams params;
+    std::size_t total_trades = 0;
+    double average_trade_size = 0.0;
+    double realized_pnl = 0.0;
+    double max_drawdown = 0.0;
+    bool risk_breached = false;
+};
+
+/**
+ * @class SweepRunner
+ * @brief Replays one in-memory dataset through many independent Simulator + strategy runs.
+ *
+ * The tick data is loaded once and shared read-only by every run. Each run
+ * owns its Simulator (and therefore its books and simulated clock), so runs
+ * share no mutable state and are spread over a fixed set of worker threads.
+ */
+class SweepRunner {
+public:
+    /**
+     * @brief Builds and configures the strategy for one run.
+     *
+     * Called on a worker thread with a fresh Simulator; the returned strategy
+     * is registered with it by the runner under owner_id, so it should submit
+     * through makeSubmitter(owner_id).
+     */
+    using StrategyFactory =
+        std::function<std::shared_ptr<strategy::Strategy>(Simulator&, const SweepParams&)>;
+
+    /// Owner ID each run's strategy is registered under.
+    static constexpr uint32_t owner_id = 1;
+
+    /**
+     * @param ticks Market data shared by every run
+     * @param factory Strategy factory invoked once per run
+     * @param threads Worker threads (0 = hardware concurrency)
+     */
+    SweepRunner(std::shared_ptr<const std::vector<core::Order>> ticks,
+                StrategyFactory factory,
+                unsigned threads = 0);
+
+    /**
+     * @brief Runs every parameter set and returns their results in grid order.
+     *
+     * Rethrows the first exception raised by a run once all workers have finished.
+     */
+    std::vector<SweepResult> run(const std::vector<SweepParams>& grid) const;
+
+    /**
+     * @brief Runs a single parameter set on the calling thread.
+     */
+    SweepResult runOne(const SweepParams& params) const;
+
+    /**
+     * @brief Cartesian product of the given parameter values.
+     */
+    static std::vector<SweepParams> grid(const std::vector<double>& spreads,
+                                         const std::vector<int>& sizes,
+                                         const std::vector<double>& risks);
+
+    /**
+     * @brief Writes results as a CSV table, one row per run.
+     */
+    static void writeCsv(const std::vector<SweepResult>& results, const std::string& path);
+
+private:
+    std::shared_ptr<const std::vector<core::Order>> ticks_;
+    StrategyFactory factory_;
+    unsigned threads_;
+};
+
+}
@@ -0,0 +1,135 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Declares the work-stealing thread pool and strands used to host strategies.
+ */
+
+#pragma once
+
+#include "engine/clock.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+using Task = std::function<void()>;
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of workers, each with its own task deque, that steal from each other when idle.
+ *
+ * Tasks submitted from a worker go to the back of that worker's deque and are
+ * taken LIFO by it; idle workers steal FIFO from the front of other deques.
+ * Tasks from outside the pool are spread round-robin. The destructor runs
+ * every queued task before joining the workers.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Worker count (0 = hardware concurrency)
+     */
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task to run on some worker.
+     */
+    void submit(Task task);
+
+    /// Number of worker threads.
+    unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<unsigned> next_{0};        ///< Round-robin target for external submits
+    std::atomic<std::size_t> pending_{0};  ///< Queued tasks not yet taken by a worker
+    bool stopping_ = false;
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+
+    bool take(unsigned index, Task& task);
+    void run(unsigned index);
+};
+
+/**
+ * @class Strand
+ * @brief Runs posted tasks one at a time, in order, on a ThreadPool.
+ *
+ * A strand is never on more than one worker at once, so code that only runs
+ * through its strand can be written as if it were single-threaded. At most a
+ * small batch of tasks runs per turn before the strand yields its worker.
+ * The pool must outlive the strand.
+ */
+class Strand : public std::enable_shared_from_this<Strand> {
+public:
+    explicit Strand(ThreadPool& pool) : pool_(pool) {}
+
+    /**
+     * @brief Queues a task behind everything already posted to this strand.
+     */
+    void post(Task task);
+
+    /**
+     * @brief Posts a task and waits for it to finish. Must not be called from the strand itself.
+     */
+    void invoke(Task task);
+
+private:
+    static constexpr std::size_t batch_size_ = 64;
+
+    ThreadPool& pool_;
+    std::mutex mutex_;
+    std::deque<Task> queue_;
+    bool scheduled_ = false;  ///< A drain task is queued or running
+
+    void drain();
+};
+
+/**
+ * @class StrandClock
+ * @brief Clock that delivers another clock's timer callbacks through a strand.
+ *
+ * Time comes from the wrapped clock. A periodic timer whose previous call is
+ * still waiting on the strand is not queued again, so a slow strategy skips
+ * ticks instead of building a backlog. A canceled timer never runs again,
+ * even if a call was already queued.
+ */
+class StrandClock : public Clock {
+public:
+    StrandClock(std::shared_ptr<Clock> clock, std::shared_ptr<Strand> strand)
+        : clock_(std::move(clock)), strand_(std::move(strand)) {}
+
+    uint64_t now() const override { return clock_->now(); }
+    TimerId schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) override;
+    void cancel(TimerId id) override;
+
+private:
+    struct TimerState {
+        std::atomic<bool> active{true};
+        std::atomic<bool> queued{false};
+    };
+
+    std::shared_ptr<Clock> clock_;
+    std::shared_ptr<Strand> strand_;
+    std::mutex mutex_;
+    std::unordered_map<TimerId, std::shared_ptr<TimerState>> timers_;
+};
+
+}
@@ -0,0 +1,34 @@
+/**
+ * @file tick_columns.hpp
+ * @brief Declares loading of recorded ticks into per-instrument columns for batch indicators.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @struct TickColumns
+ * @brief One instrument's ticks as contiguous arrays, in journal order.
+ */
+struct TickColumns {
+    std::vector<uint64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<double> quantities;
+};
+
+/**
+ * @brief Reads every market data tick of a journal (see JournalWriter) into columns.
+ *
+ * The columns feed the core::batch kernels directly, e.g. to precompute
+ * signals for a research run or to warm up strategy state before start().
+ * @throws std::runtime_error if the file is not a journal
+ */
+std::map<std::string, TickColumns> loadTickColumns(const std::string& journal_path);
+
+}
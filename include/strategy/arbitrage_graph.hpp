@@ -0,0 +1,133 @@
+/**
+ * @file arbitrage_graph.hpp
+ * @brief Declares a currency graph that detects cyclic arbitrage incrementally as pair prices change.
+ */
+
+#pragma once
+
+#include "core/order.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief One trade of a cycle: buy or sell the base currency of a pair.
+ */
+struct CycleLeg {
+    std::size_t pair;  ///< ArbitrageGraph pair index
+    core::Side side;   ///< BUY pays the ask in quote currency, SELL receives the bid
+};
+
+/**
+ * @brief A cycle whose legs, traded in order, return more than they started with.
+ */
+struct ArbitrageOpportunity {
+    std::size_t cycle;  ///< ArbitrageGraph cycle index
+    double profit;      ///< Fractional gain after fees, e.g. 0.002 for 0.2%
+};
+
+/**
+ * @class ArbitrageGraph
+ * @brief Currencies as nodes and pair quotes as log-price edges; finds negative cycles per update.
+ *
+ * A pair BASE-QUOTE contributes two edges: QUOTE -> BASE at log(ask) (buying
+ * the base) and BASE -> QUOTE at -log(bid) (selling it), each plus the fee
+ * cost -log(1 - fee). A cycle whose weights sum below zero multiplies the
+ * starting amount by more than one.
+ *
+ * Every simple cycle up to the maximum length is enumerated once, when pairs
+ * are added, and indexed by the edges it uses. A price change only touches
+ * the two edges of its pair, and a cycle that was not profitable can only
+ * become so through a changed edge, so update() re-sums just the cycles
+ * through that pair (at most max length additions each) instead of running
+ * Bellman-Ford over the whole graph. Not thread-safe.
+ */
+class ArbitrageGraph {
+public:
+    /**
+     * @param max_cycle_length Longest cycle considered, in legs (2 to 6)
+     * @param fee_rate         Proportional fee paid on every leg
+     * @param min_profit       Smallest fractional gain reported
+     */
+    explicit ArbitrageGraph(std::size_t max_cycle_length = 3, double fee_rate = 0.0, double min_profit = 0.0);
+
+    /**
+     * @brief Adds a pair named "BASE-QUOTE" (e.g. "ETH-USD").
+     * @return Pair index
+     * @throws std::invalid_argument if the name has no '-' separator or the pair already exists
+     */
+    std::size_t addPair(const std::string& instrument);
+
+    /**
+     * @brief Adds a pair with explicit currencies, e.g. two venues quoting the same pair.
+     * @return Pair index
+     * @throws std::invalid_argument if base equals quote or the instrument already exists
+     */
+    std::size_t addPair(const std::string& instrument, const std::string& base, const std::string& quote);
+
+    /**
+     * @brief Looks up a pair index.
+     * @throws std::out_of_range if the instrument was never added
+     */
+    std::size_t pairIndex(const std::string& instrument) const { return pair_index_.at(instrument); }
+
+    /**
+     * @brief Sets a pair's best bid and ask; a side at or below zero is treated as absent.
+     *
+     * Appends the profitable cycles that run through this pair to @p out.
+     */
+    void update(std::size_t pair, double bid, double ask, std::vector<ArbitrageOpportunity>& out);
+
+    /**
+     * @brief Appends every profitable cycle in the graph to @p out (full scan).
+     */
+    void profitableCycles(std::vector<ArbitrageOpportunity>& out) const;
+
+    /// Legs of a cycle in trading order.
+    std::span<const CycleLeg> legs(std::size_t cycle) const;
+
+    const std::string& instrument(std::size_t pair) const { return pairs_[pair].instrument; }
+    double bid(std::size_t pair) const { return pairs_[pair].bid; }
+    double ask(std::size_t pair) const { return pairs_[pair].ask; }
+
+    std::size_t pairCount() const { return pairs_.size(); }
+    std::size_t currencyCount() const { return currencies_.size(); }
+    std::size_t cycleCount() const { return cycle_offsets_.size() - 1; }
+
+private:
+    struct Pair {
+        std::string instrument;
+        std::size_t base;
+        std::size_t quote;
+        double bid = 0.0;
+        double ask = 0.0;
+    };
+
+    std::size_t max_cycle_length_;
+    double fee_weight_;        ///< -log(1 - fee) added to every edge
+    double profit_threshold_;  ///< Cycles must weigh less than -log(1 + min_profit)
+
+    std::vector<Pair> pairs_;
+    std::unordered_map<std::string, std::size_t> pair_index_;
+    std::unordered_map<std::string, std::size_t> currencies_;
+
+    // edge 2p buys pair p's base, edge 2p + 1 sells it
+    std::vector<double> edge_weight_;
+
+    // cycles stored flat: legs of cycle c are cycle_legs_[cycle_offsets_[c] .. cycle_offsets_[c + 1])
+    std::vector<CycleLeg> cycle_legs_;
+    std::vector<std::size_t> cycle_offsets_{0};
+    std::vector<std::vector<uint32_t>> pair_cycles_;  ///< Cycles through each pair
+
+    std::size_t currencyIndex(const std::string& currency);
+    double cycleWeight(std::size_t cycle) const;
+    void enumerateCycles();
+};
+
+}
@@ -9,14 +9,23 @@
 #include "core/order.hpp"
 #include "core/trade.hpp"
 
+#include <array>
 #include <unordered_map>
 #include <string>
 #include <atomic>
 #include <mutex>
 #include <fstream>
+#include <vector>
 
 namespace strategy {
 
+/**
+ * @class ArbitrageTrader
+ * @brief Buys one instrument and sells the other when one's bid clears the other's ask by more than the spread.
+ *
+ * Prices come from the engine's book events, so the signal always reflects
+ * the current best bid/offer of each book, including cancels and fills.
+ */
 class ArbitrageTrader : public Strategy {
 public:
     ArbitrageTrader(const std::string& asset1,
@@ -28,6 +37,7 @@ public:
 
     void onMarketData(const core::Order& order) override;
     void onTrade(const core::Trade& trade) override;
+    void onBookUpdate(const engine::BookEvent& event) override;
     void start() override;
     void stop() override;
     std::string name() const override { return "ArbitrageTrader"; }
@@ -40,6 +50,7 @@ public:
     }
     double maxDrawdown() const override { return max_drawdown_; }
     bool riskViolated() const override { return risk_violated_; }
+    double realizedPnL() const override { return realized_pnl_; }
 
     int getPosition(const std::string& symbol) const {
     auto it = positions_.find(symbol);
@@ -60,8 +71,7 @@ private:
     std::atomic<bool> running_;
     std::mutex mutex_;
 
-    std::unordered_map<std::string, double> best_bid_;
-    std::unordered_map<std::string, double> best_ask_;
+    std::array<engine::TopOfBook, 2> top_{};  ///< Latest BBO of symbol1_ and symbol2_
 
     double realized_pnl_ = 0.0;
     std::unordered_map<std::string, int> positions_;
@@ -74,7 +84,13 @@ private:
     double max_drawdown_ = 0.0;
     bool risk_violated_ = false;
 
-    void checkArbitrageOpportunity();
+    /// Appends the orders for any opportunity in top_ to @p orders. Called with mutex_ held.
+    void checkArbitrageOpportunity(std::vector<core::Order>& orders);
+
+    /// 0 for symbol1_, 1 for symbol2_, -1 for anything else.
+    int legIndex(const std::string& instrument) const {
+        return instrument == symbol1_ ? 0 : instrument == symbol2_ ? 1 : -1;
+    }
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * @file cycle_arbitrage_trader.hpp
+ * @brief Defines a strategy that trades the profitable cycles an ArbitrageGraph finds across many pairs.
+ */
+
+#pragma once
+
+#include "strategy/strategy.hpp"
+#include "strategy/arbitrage_graph.hpp"
+#include "core/order.hpp"
+#include "core/trade.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @class CycleArbitrageTrader
+ * @brief Feeds book BBO events into an ArbitrageGraph and trades every cycle it reports.
+ *
+ * Each pair is subscribed for trades and book events. A BBO change updates
+ * that pair's edges, and each profitable cycle through it is sent as one
+ * limit order per leg at the touch (ask for a buy, bid for a sell), every leg
+ * for the same base quantity. Orders are built under the trader's lock and
+ * submitted after it is released, since the engine may deliver their fills
+ * before the submit returns.
+ */
+class CycleArbitrageTrader : public Strategy {
+public:
+    /**
+     * @param pairs            Instruments named "BASE-QUOTE", e.g. ETH-USD, BTC-USD, ETH-BTC
+     * @param submit           Order submission callback
+     * @param order_size       Base quantity of every leg
+     * @param min_profit       Smallest fractional gain traded, after fees
+     * @param fee_rate         Proportional fee paid on every leg
+     * @param max_cycle_length Longest cycle considered, in legs
+     * @throws std::invalid_argument for bad pair names or graph parameters
+     */
+    CycleArbitrageTrader(const std::vector<std::string>& pairs,
+                         SubmitOrderCallback submit,
+                         int order_size,
+                         double min_profit,
+                         double fee_rate = 0.0,
+                         std::size_t max_cycle_length = 3);
+
+    void onMarketData(const core::Order& order) override;
+    void onTrade(const core::Trade& trade) override;
+    void onBookUpdate(const engine::BookEvent& event) override;
+    void start() override;
+    void stop() override;
+    std::string name() const override { return "CycleArbitrageTrader"; }
+    void printSummary() const override;
+    void exportSummary(const std::string& path) const override;
+
+    size_t totalTrades() const override { return total_trades_; }
+    double averageTradeSize() const override {
+        return total_trades_ > 0 ? static_cast<double>(total_quantity_) / total_trades_ : 0.0;
+    }
+
+    /// Signed filled base quantity in an instrument.
+    int getPosition(const std::string& instrument) const;
+
+    /// Cycles traded so far.
+    size_t cyclesTraded() const { return cycles_traded_; }
+
+private:
+    std::vector<std::string> pairs_;
+    SubmitOrderCallback submit_;
+    uint32_t order_size_;
+    std::atomic<bool> running_{false};
+    mutable std::mutex mutex_;
+
+    ArbitrageGraph graph_;
+    std::vector<ArbitrageOpportunity> found_;  ///< Reused by every update
+
+    std::unordered_map<uint64_t, core::Side> own_orders_;  ///< Submitted order ID -> side
+    std::unordered_map<std::string, int> positions_;
+
+    size_t cycles_traded_ = 0;
+    size_t total_trades_ = 0;
+    uint64_t total_quantity_ = 0;
+};
+
+}
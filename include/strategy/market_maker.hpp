@@ -7,8 +7,12 @@
 
 #include "strategy/strategy.hpp"
 #include "engine/order_book.hpp"
+#include "strategy/quoting_model.hpp"
+#include "core/indicators.hpp"
 
+#include <array>
 #include <chrono>
+#include <memory>
 #include <unordered_set>
 #include <functional>
 #include <fstream>
@@ -18,6 +22,12 @@ namespace strategy {
 /**
  * @class MarketMaker
  * @brief A simple market-making strategy that places passive bid/ask orders near mid-price.
+ *
+ * Quotes are refreshed every 500ms. When subscribed to book events it also
+ * re-quotes as soon as the mid moves away from the one it last quoted around.
+ * Prices and sizes come from a QuotingModel (SymmetricQuoting unless replaced)
+ * fed with incrementally maintained estimates: tick-flow imbalance, short-term
+ * volatility, tick rate and the average depth trades print at.
  */
 class MarketMaker : public Strategy {
 public:
@@ -40,6 +50,8 @@ public:
     void stop() override;
     void onMarketData(const core::Order& order) override;
     void onTrade(const core::Trade& trade) override;
+    void onBookUpdate(const engine::BookEvent& event) override;
+    void onOrderRejected(const core::Order& order, engine::RejectReason reason) override;
     std::string name() const override;
     void printSummary() const override;
     void exportSummary(const std::string& path) const override;
@@ -51,18 +63,53 @@ public:
     }
     double maxDrawdown() const override { return max_drawdown_; }
     bool riskViolated() const override { return risk_violated_; }
+    double realizedPnL() const override { return realized_pnl_; }
+
+    /**
+     * @brief Replaces the quoting model. Call before start().
+     */
+    void setQuotingModel(std::unique_ptr<QuotingModel> model);
+
+    /**
+     * @brief Buy minus sell tick volume over the recent window, in [-1, 1].
+     */
+    double flowImbalance() const;
+
+    /**
+     * @brief Standard deviation of tick-to-tick price returns over the recent window.
+     */
+    double shortTermVolatility() const;
 
 private:
+    /// Compact copy of an incoming tick; the instrument is implied.
+    struct MarketTick {
+        uint64_t timestamp;
+        double price;
+        uint32_t quantity;
+        core::Side side;
+    };
     std::string symbol_;
     engine::OrderBook& book_;
     SubmitOrderCallback submitOrder_;
     std::atomic<bool> running_;
-    std::thread worker_;
-
-    std::mutex market_mutex_;
-    std::vector<core::Order> recent_market_orders_;
-    uint64_t current_bid_id_ = 0;
-    uint64_t current_ask_id_ = 0;
+    engine::TimerId quote_timer_ = 0;
+
+    mutable std::mutex market_mutex_;
+    static constexpr std::size_t tick_window_ = 100;
+    core::FixedRing<MarketTick> recent_ticks_{tick_window_};
+    double buy_volume_ = 0.0;   ///< Tick volume on each side within recent_ticks_
+    double sell_volume_ = 0.0;
+    core::RollingStats tick_returns_{tick_window_};
+    core::Ema tick_interval_{0.05};  ///< Microseconds between ticks
+    uint64_t last_tick_ts_ = 0;
+    core::Ema trade_depth_{0.05};    ///< Distance of trades from the quoted mid
+
+    std::unique_ptr<QuotingModel> quoting_model_;
+    std::array<uint64_t, QuoteSet::max_levels> bid_ids_{};  ///< Resting quote per level (0 = none)
+    std::array<uint64_t, QuoteSet::max_levels> ask_ids_{};
+    double quoted_mid_ = -1.0;  ///< Mid of the last placeQuotes() (-1 = none)
+    double quoted_center_ = -1.0;  ///< Price the last quotes were centered on after skew
+    static constexpr double max_price_drift_ = 0.02;  ///< Price move that forces a re-quote
 
     std::atomic<uint64_t> order_id_counter_ = 1;
 
@@ -89,18 +136,22 @@ private:
     std::ofstream metrics_log_;
     std::ofstream trade_log_;
 
-    void run();
-
     /**
-     * @brief Creates symmetric bid/ask orders around mid-price.
+     * @brief Asks the quoting model for a quote set and replaces levels that moved or expired.
      */
     void placeQuotes();
 
     /**
-     * @brief Computes mid price from the order book.
+     * @brief Snapshot of the market estimates for the quoting model.
+     */
+    MarketState marketState(const engine::TopOfBook& top, double mid, int inventory) const;
+
+    /**
+     * @brief Computes mid price from a top-of-book sample.
+     * @param top BBO read once from the book
      * @return Mid-price or -1 if no data available
      */
-    double computeMidPrice();
+    double computeMidPrice(const engine::TopOfBook& top) const;
 
     core::Order createOrder(core::Side side, double price, uint32_t qty, uint64_t ts);
     
@@ -7,7 +7,9 @@
 
 #include "strategy/strategy.hpp"
 #include "engine/order_book.hpp"
+#include "core/indicators.hpp"
 
+#include <span>
 #include <vector>
 #include <mutex>
 #include <atomic>
@@ -20,20 +22,29 @@ namespace strategy {
 /**
  * @class MomentumTrader
  * @brief A trading strategy that reacts to short-term price momentum.
+ *
+ * Evaluates every 200ms, or on each book change instead when subscribed to
+ * book events: buys when the latest price is above the mean of the rest of
+ * its rolling window, sells otherwise.
  */
 class MomentumTrader : public Strategy {
 public:
     using SubmitOrderCallback = std::function<void(const core::Order&)>;
 
+    /**
+     * @param window Number of recent prices the signal looks at
+     */
     explicit MomentumTrader(
         const std::string& symbol,
         SubmitOrderCallback submit_fn,
-        double max_loss);
+        double max_loss,
+        std::size_t window = 5);
 
     void start() override;
     void stop() override;
     void onMarketData(const core::Order& order) override;
     void onTrade(const core::Trade& trade) override;
+    void onBookUpdate(const engine::BookEvent& event) override;
     std::string name() const override;
     void printSummary() const override;
     void exportSummary(const std::string& path) const override;
@@ -45,15 +56,24 @@ public:
     }
     double maxDrawdown() const override { return max_drawdown_; }
     bool riskViolated() const override { return risk_violated_; }
+    double realizedPnL() const override { return realized_pnl_; }
+
+    /**
+     * @brief Fills the price window from history (e.g. a TickColumns column). Call before start().
+     */
+    void warmUp(std::span<const double> prices);
+
+    void saveState(std::string& out) const override;
+    void restoreState(std::string_view state) override;
 
 private:
     std::string symbol_;
     SubmitOrderCallback submitOrder_;
     std::atomic<bool> running_;
-    std::thread worker_;
+    engine::TimerId eval_timer_ = 0;
 
     mutable std::mutex data_mutex_;
-    std::vector<double> recent_prices_;  // e.g., last N mid prices
+    core::RollingStats recent_prices_;  // last N tick prices, O(1) per tick
 
     uint64_t cooldown_end_ts_ = 0;
 
@@ -70,7 +90,6 @@ private:
 
     std::ofstream trade_log_;
 
-    void run();
     void evaluateMomentum();
     double getLatestPrice() const;
     uint64_t nowMicros() const;
@@ -0,0 +1,116 @@
+/**
+ * @file quoting_model.hpp
+ * @brief Declares the quoting models MarketMaker uses to turn market estimates into quotes.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace strategy {
+
+/**
+ * @brief Market estimates a quoting model prices from, sampled once per quote decision.
+ */
+struct MarketState {
+    double mid = 0.0;               ///< Book mid price
+    double book_half_spread = 0.0;  ///< Half the best bid/offer spread
+    int inventory = 0;              ///< Signed position, positive when long
+    int inventory_limit = 0;        ///< Largest absolute position the strategy may hold
+    double tick_volatility = 0.0;   ///< Standard deviation of tick-to-tick returns
+    double tick_rate = 0.0;         ///< Ticks per second
+    double flow_imbalance = 0.0;    ///< Buy minus sell tick volume share, in [-1, 1]
+    double trade_depth = 0.0;       ///< Average distance of trades from the mid (0 = none seen)
+};
+
+/**
+ * @brief One price level of a quote.
+ */
+struct QuoteLevel {
+    double price = 0.0;
+    uint32_t quantity = 0;
+};
+
+/**
+ * @brief Bid and ask ladders, best level first, in fixed storage so quoting never allocates.
+ */
+struct QuoteSet {
+    static constexpr std::size_t max_levels = 4;
+    std::array<QuoteLevel, max_levels> bids{};
+    std::array<QuoteLevel, max_levels> asks{};
+    std::size_t bid_levels = 0;
+    std::size_t ask_levels = 0;
+};
+
+/**
+ * @class QuotingModel
+ * @brief Computes the quotes to show for the current market state.
+ */
+class QuotingModel {
+public:
+    virtual ~QuotingModel() = default;
+
+    /**
+     * @brief Fills @p out with the quotes to show; levels left out are withdrawn.
+     */
+    virtual void quote(const MarketState& state, QuoteSet& out) const = 0;
+};
+
+/**
+ * @class SymmetricQuoting
+ * @brief One unit each side at the book spread, widened by volatility and leaning with the flow.
+ */
+class SymmetricQuoting : public QuotingModel {
+public:
+    /**
+     * @param flow_skew Share of the half-spread the quotes shift at full flow imbalance
+     * @param vol_widen Minimum half-spread in tick-return standard deviations
+     */
+    explicit SymmetricQuoting(double flow_skew = 0.5, double vol_widen = 2.0)
+        : flow_skew_(flow_skew), vol_widen_(vol_widen) {}
+
+    void quote(const MarketState& state, QuoteSet& out) const override;
+
+private:
+    double flow_skew_;
+    double vol_widen_;
+};
+
+/**
+ * @class AvellanedaStoikovQuoting
+ * @brief Inventory-aware quotes from the Avellaneda–Stoikov model, laid out over several levels.
+ *
+ * Quotes center on the reservation price r = mid - q * gamma * sigma^2 * T,
+ * which moves away from the side the inventory q is already on, with a total
+ * spread of gamma * sigma^2 * T + (2 / gamma) * ln(1 + gamma / k). sigma^2 is
+ * the price variance per second (tick volatility scaled by the tick rate) and
+ * k the decay of fill intensity with distance from the mid, estimated as one
+ * over the average trade depth. Quantities stop at the inventory limit.
+ */
+class AvellanedaStoikovQuoting : public QuotingModel {
+public:
+    struct Params {
+        double risk_aversion = 0.1;     ///< gamma
+        double horizon_s = 1.0;         ///< T, seconds of inventory risk priced in
+        std::size_t levels = 3;         ///< Levels per side, at most QuoteSet::max_levels
+        double level_spacing = 0.5;     ///< Gap between levels as a share of the half-spread
+        uint32_t level_size = 1;        ///< Quantity per level
+        double min_half_spread = 0.01;
+    };
+
+    AvellanedaStoikovQuoting() : AvellanedaStoikovQuoting(Params{}) {}
+
+    /**
+     * @throws std::invalid_argument on a non-positive risk aversion or an invalid level count
+     */
+    explicit AvellanedaStoikovQuoting(const Params& params);
+
+    void quote(const MarketState& state, QuoteSet& out) const override;
+
+private:
+    Params params_;
+};
+
+}
@@ -7,37 +7,96 @@
 
 #include "core/order.hpp"
 #include "core/trade.hpp"
+#include "engine/clock.hpp"
+#include "engine/order_book.hpp"
+#include "engine/risk_gateway.hpp"
 
 #include <string>
+#include <string_view>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace strategy {
 
 // callback for submitting an order to the exchange
 using SubmitOrderCallback = std::function<void(const core::Order&)>;
 
+/**
+ * @brief Engine events a strategy can subscribe to per instrument (bit mask).
+ */
+enum EventType : uint32_t {
+    MARKET_DATA  = 1u << 0,  ///< onMarketData
+    TRADES       = 1u << 1,  ///< onTrade
+    BOOK_UPDATES = 1u << 2,  ///< onBookUpdate, also needs subscribeBookEvents()
+    ALL_EVENTS   = MARKET_DATA | TRADES | BOOK_UPDATES
+};
+
 /**
  * @class Strategy
  * @brief Abstract base class for trading strategies.
  *
- * Each strategy processes market data and submits orders. Designed to be run in its own thread.
+ * Each strategy processes market data and submits orders. Time and periodic
+ * work come from the strategy's Clock, so the same strategy runs in wall time
+ * or in simulated time depending on the clock it is given.
  */
 class Strategy {
 public:
+    Strategy() : clock_(std::make_shared<engine::RealTimeClock>()) {}
     virtual ~Strategy() = default;
 
+    /**
+     * @brief Sets the clock used for timestamps and timers. Call before start().
+     * @param clock Clock shared with the engine (defaults to a real-time clock)
+     */
+    void setClock(std::shared_ptr<engine::Clock> clock) { clock_ = std::move(clock); }
+
+    /**
+     * @brief Sets the directory log files are written to. Call before start().
+     * @param dir Log directory (defaults to "logs"); empty disables file logging
+     */
+    void setLogDirectory(std::string dir) { log_dir_ = std::move(dir); }
+
+    /**
+     * @brief Asks the engine to push book changes to onBookUpdate(). Call before registering.
+     * @param coalesce Merge changes that pile up while the strategy is busy into one callback
+     */
+    void subscribeBookEvents(bool coalesce = true) {
+        book_events_ = true;
+        coalesce_book_events_ = coalesce;
+    }
+
+    bool bookEventsEnabled() const { return book_events_; }
+    bool coalesceBookEvents() const { return coalesce_book_events_; }
+
+    /**
+     * @brief Limits the events the engine delivers to the given instrument. Call before registering.
+     *
+     * May be called once per instrument. A strategy that never subscribes
+     * receives every event for every instrument.
+     * @param instrument Instrument to receive events for
+     * @param events EventType bits to receive for it
+     */
+    void subscribe(const std::string& instrument, uint32_t events = ALL_EVENTS) {
+        subscriptions_.emplace_back(instrument, events);
+    }
+
+    /// Instrument subscriptions as (instrument, EventType mask); empty = everything.
+    const std::vector<std::pair<std::string, uint32_t>>& subscriptions() const { return subscriptions_; }
+
     /**
      * @brief Starts the strategy’s processing loop.
      */
     virtual void start() = 0;
 
     /**
-     * @brief Stops the strategy’s loop and joins its thread.
+     * @brief Stops the strategy and cancels its timers.
      */
     virtual void stop() = 0;
 
@@ -53,6 +112,20 @@ public:
      */
     virtual void onTrade(const core::Trade& trade) = 0;
 
+    /**
+     * @brief Reacts to a best bid/offer change or trade print, if subscribed.
+     * @param event Book change published by the engine
+     */
+    virtual void onBookUpdate(const engine::BookEvent& /*event*/) {}
+
+    /**
+     * @brief Learns that the engine's risk gateway refused one of its orders.
+     *
+     * The order never reached the book. Delivered after the submitting
+     * callback returns, never inside it.
+     */
+    virtual void onOrderRejected(const core::Order& /*order*/, engine::RejectReason /*reason*/) {}
+
     /**
      * @brief Gets the name of the strategy.
      * @return Name as a string
@@ -93,6 +166,45 @@ public:
      * @return True if risk limits are violated, false otherwise
      */
     virtual bool riskViolated() const { return false; }
+
+    /**
+     * @brief Returns the realized profit and loss of the strategy.
+     * @return Realized PnL
+     */
+    virtual double realizedPnL() const { return 0.0; }
+
+    /**
+     * @brief Appends what a resumed run needs (position, PnL, signal history) to @p out.
+     *
+     * Saved into engine checkpoints; the default saves nothing.
+     */
+    virtual void saveState(std::string& /*out*/) const {}
+
+    /**
+     * @brief Restores state written by saveState(). Called before start().
+     * @throws std::runtime_error if @p state was not written by this strategy type
+     */
+    virtual void restoreState(std::string_view /*state*/) {}
+
+protected:
+    /**
+     * @brief Clock to read time from and schedule timers on.
+     */
+    engine::Clock& clock() const { return *clock_; }
+
+    /**
+     * @brief Path of a log file in the log directory, or empty if logging is disabled.
+     */
+    std::string logPath(const std::string& file) const {
+        return log_dir_.empty() ? std::string() : log_dir_ + "/" + file;
+    }
+
+private:
+    std::shared_ptr<engine::Clock> clock_;
+    std::string log_dir_ = "logs";
+    bool book_events_ = false;
+    bool coalesce_book_events_ = true;
+    std::vector<std::pair<std::string, uint32_t>> subscriptions_;
 };
 
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "core/order.hpp"
+#include "core/event_bus.hpp"
 #include "engine/order_book.hpp"
+#include "engine/checkpoint.hpp"
 #include "engine/market_data_handler.hpp"
 #include "engine/simulator.hpp"
+#include "engine/sweep_runner.hpp"
 #include "strategy/market_maker.hpp"
 #include "strategy/momentum_trader.hpp"
 #include "strategy/arbitrage_trader.hpp"
+#include "strategy/cycle_arbitrage_trader.hpp"
 #include <nlohmann/json.hpp>
 
 #include <iostream>
@@ -13,7 +17,10 @@
 #include <thread>
 #include <csignal>
 #include <atomic>
+#include <set>
 #include <unordered_map>
+#include <sstream>
+#include <streambuf>
 
 using json = nlohmann::json;
 
@@ -24,6 +31,12 @@ using namespace strategy;
 // Global stop signal
 std::atomic<bool> running{true};
 
+// Discards console output while sweep workers run
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
 // Graceful shutdown on Ctrl+C
 void signalHandler(int signum) {
     std::cout << "\n[INFO] Interrupt signal received. Shutting down...\n";
@@ -51,51 +64,286 @@ int main(int argc, char* argv[]) {
     double spread = args.count("spread") ? std::stod(args["spread"]) : config.value("spread", 0.02);
     int size = args.count("size") ? std::stoi(args["size"]) : config.value("size", 10);
     double max_loss = args.count("risk") ? std::stod(args["risk"]) : config.value("risk", -500.0);
+    std::string stp = args.count("stp") ? args["stp"] : config.value("stp", std::string("cancel_newest"));
+    std::string mode = args.count("mode") ? args["mode"] : config.value("mode", std::string("backtest"));
+    uint64_t order_latency = args.count("latency") ? std::stoull(args["latency"]) : config.value("latency", 0ULL);
+    uint64_t md_latency = args.count("md-latency") ? std::stoull(args["md-latency"]) : config.value("md_latency", 0ULL);
+    std::string fills = args.count("fills") ? args["fills"] : config.value("fills", std::string("book"));
+    std::string journal = args.count("journal") ? args["journal"] : config.value("journal", std::string(""));
+    std::string checkpoint = args.count("checkpoint") ? args["checkpoint"] : config.value("checkpoint", std::string(""));
+    std::string resume = args.count("resume") ? args["resume"] : config.value("resume", std::string(""));
+    std::string trigger = args.count("trigger") ? args["trigger"] : config.value("trigger", std::string("timer"));
+    RiskLimits limits;
+    limits.max_order_quantity = args.count("max-order") ? std::stoul(args["max-order"]) : config.value("max_order", 0u);
+    limits.price_collar = args.count("collar") ? std::stod(args["collar"]) : config.value("collar", 0.0);
+    limits.max_position = args.count("max-position") ? std::stoll(args["max-position"]) : config.value("max_position", 0LL);
+    limits.max_notional = args.count("max-notional") ? std::stod(args["max-notional"]) : config.value("max_notional", 0.0);
+    limits.max_orders_per_second = args.count("max-rate") ? std::stoul(args["max-rate"]) : config.value("max_rate", 0u);
+    bool risk_gateway = limits.max_order_quantity > 0 || limits.price_collar > 0.0 || limits.max_position > 0 ||
+                        limits.max_notional > 0.0 || limits.max_orders_per_second > 0;
+    std::string quoting = args.count("quoting") ? args["quoting"] : config.value("quoting", std::string("symmetric"));
+    std::vector<std::string> pairs;
+    {
+        std::istringstream ss(args.count("pairs") ? args["pairs"] : config.value("pairs", std::string("ETH-USD,BTC-USD,ETH-BTC")));
+        for (std::string pair; std::getline(ss, pair, ',');) {
+            pairs.push_back(pair);
+        }
+    }
+
+    // every book the strategy may send orders to, registered with the gateway and position keeper
+    const std::vector<std::string> strategy_instruments =
+        strategy == "cycle" ? pairs : std::vector<std::string>{"ETH-USD", "BTC-USD"};
 
     std::cout << "[ENGINE] Strategy: " << strategy
               << ", File: " << file
               << ", Spread: " << spread
               << ", Size: " << size
-              << ", Max Loss: " << max_loss << "\n";
-
-    Simulator simulator;
-
-    std::shared_ptr<Strategy> strat;
-
-    static engine::OrderBook shared_book("ETH-USD");
-    if (strategy == "marketmaker") {
-        strat = std::make_shared<MarketMaker>("ETH-USD", shared_book,
-            [&](const Order& o) { simulator.onOrder(o); }, max_loss);
-    } else if (strategy == "momentum") {
-        strat = std::make_shared<MomentumTrader>("ETH-USD",
-            [&](const Order& o) { simulator.onOrder(o); }, max_loss);
-    } else if (strategy == "arbitrage") {
-        strat = std::make_shared<ArbitrageTrader>("ETH-USD", "BTC-USD",
-            [&](const Order& o) { simulator.onOrder(o); }, spread, size, max_loss);
-    } else {
+              << ", Max Loss: " << max_loss
+              << ", Mode: " << mode << "\n";
+
+    if (mode != "backtest" && mode != "live" && mode != "sweep" && mode != "replay") {
+        std::cerr << "[ERROR] Unknown mode: " << mode << std::endl;
+        return 1;
+    }
+    if (strategy != "marketmaker" && strategy != "momentum" && strategy != "arbitrage" && strategy != "cycle") {
         std::cerr << "[ERROR] Unknown strategy: " << strategy << std::endl;
         return 1;
     }
 
-    simulator.registerStrategy(strat);
+    static const std::unordered_map<std::string, SelfTradePrevention> stp_modes = {
+        {"none", SelfTradePrevention::NONE},
+        {"cancel_newest", SelfTradePrevention::CANCEL_NEWEST},
+        {"cancel_oldest", SelfTradePrevention::CANCEL_OLDEST},
+        {"cancel_both", SelfTradePrevention::CANCEL_BOTH},
+        {"decrement", SelfTradePrevention::DECREMENT}
+    };
+    if (!stp_modes.count(stp)) {
+        std::cerr << "[ERROR] Unknown self-trade prevention mode: " << stp << std::endl;
+        return 1;
+    }
+    if (fills != "book" && fills != "queue") {
+        std::cerr << "[ERROR] Unknown fill model: " << fills << std::endl;
+        return 1;
+    }
+    if (trigger != "timer" && trigger != "book") {
+        std::cerr << "[ERROR] Unknown strategy trigger: " << trigger << std::endl;
+        return 1;
+    }
+    if (quoting != "symmetric" && quoting != "as") {
+        std::cerr << "[ERROR] Unknown quoting model: " << quoting << std::endl;
+        return 1;
+    }
+
+    // engine settings shared by single runs and every sweep run
+    auto configure = [&](Simulator& sim) {
+        sim.setSelfTradePrevention(stp_modes.at(stp));
+        sim.setQueuePositionFills(fills == "queue");
+        if (order_latency > 0) {
+            sim.setOrderEntryLatency(std::make_unique<FixedLatency>(order_latency));
+        }
+        if (md_latency > 0) {
+            sim.setMarketDataLatency(std::make_unique<FixedLatency>(md_latency));
+        }
+        if (risk_gateway) {
+            auto gateway = std::make_shared<RiskGateway>();
+            for (const auto& instrument : strategy_instruments) {
+                gateway->addInstrument(instrument, &sim.getBook(instrument));
+            }
+            gateway->addAccount(SweepRunner::owner_id, limits);
+            sim.setRiskGateway(gateway);
+        }
+    };
+
+    auto make_strategy = [&](Simulator& sim, const SweepParams& p) -> std::shared_ptr<Strategy> {
+        std::shared_ptr<Strategy> strat;
+        if (strategy == "marketmaker") {
+            auto mm = std::make_shared<MarketMaker>("ETH-USD", sim.getBook("ETH-USD"),
+                sim.makeSubmitter(SweepRunner::owner_id), p.risk);
+            if (quoting == "as") {
+                mm->setQuotingModel(std::make_unique<AvellanedaStoikovQuoting>());
+            }
+            strat = mm;
+        } else if (strategy == "momentum") {
+            strat = std::make_shared<MomentumTrader>("ETH-USD",
+                sim.makeSubmitter(SweepRunner::owner_id), p.risk);
+        } else if (strategy == "cycle") {
+            // --spread is the minimum fractional gain of a cycle here
+            strat = std::make_shared<CycleArbitrageTrader>(pairs,
+                sim.makeSubmitter(SweepRunner::owner_id), p.size, p.spread);
+        } else {
+            strat = std::make_shared<ArbitrageTrader>("ETH-USD", "BTC-USD",
+                sim.makeSubmitter(SweepRunner::owner_id), p.spread, p.size, p.risk);
+        }
+        if (trigger == "book") {
+            strat->subscribeBookEvents();
+        }
+        return strat;
+    };
+
+    if (mode == "sweep") {
+        const json sweep = config.value("sweep", json::object());
+
+        // --spread 0.01,0.02 on the command line, else a "sweep" list in config.json
+        auto values = [&](const std::string& key, auto fallback) {
+            using T = decltype(fallback);
+            std::vector<T> out;
+            if (args.count(key)) {
+                std::istringstream ss(args[key]);
+                std::string token;
+                while (std::getline(ss, token, ',')) {
+                    out.push_back(static_cast<T>(std::stod(token)));
+                }
+            } else if (sweep.contains(key)) {
+                out = sweep[key].get<std::vector<T>>();
+            }
+            if (out.empty()) out.push_back(fallback);
+            return out;
+        };
+
+        auto grid = SweepRunner::grid(values("spread", spread), values("size", size), values("risk", max_loss));
+        unsigned threads = args.count("threads") ? std::stoul(args["threads"]) : config.value("threads", 0u);
+        std::string out_path = args.count("out") ? args["out"] : config.value("out", std::string("logs/sweep_results.csv"));
+
+        MarketDataHandler md_handler(file);
+        auto ticks = std::make_shared<const std::vector<Order>>(md_handler.loadOrders());
+
+        SweepRunner runner(ticks, [&](Simulator& sim, const SweepParams& p) {
+            configure(sim);
+            auto strat = make_strategy(sim, p);
+            strat->setLogDirectory(""); // one results table instead of per-run logs
+            return strat;
+        }, threads);
+
+        std::cout << "[ENGINE] Sweeping " << grid.size() << " runs over "
+                  << ticks->size() << " ticks" << std::endl;
+
+        // per-order console logging would serialize the workers on stdout
+        NullBuffer null_buffer;
+        std::streambuf* console = std::cout.rdbuf(&null_buffer);
+        auto results = runner.run(grid);
+        std::cout.rdbuf(console);
+
+        SweepRunner::writeCsv(results, out_path);
+        std::cout << "[ENGINE] Sweep results written to " << out_path << "\n";
+        return 0;
+    }
+
+    if (mode == "replay") {
+        if (journal.empty()) {
+            std::cerr << "[ERROR] Replay mode needs --journal <path>" << std::endl;
+            return 1;
+        }
+
+        // rebuild the books from the recorded events; strategy orders come from the journal
+        Simulator simulator;
+        configure(simulator);
+        JournalReader reader(journal);
+        std::set<std::string> instruments;
+        if (!resume.empty()) {
+            // pick up the books from the checkpoint and only replay what came after it
+            uint64_t offset = simulator.restoreCheckpoint(resume);
+            MappedCheckpoint saved(resume);
+            for (const auto& book : saved.books()) {
+                instruments.emplace(book.instrument);
+            }
+            reader.skipTo(offset);
+            std::cout << "[REPLAY] Resuming from " << resume << " at journal record " << offset << "\n";
+        }
+        JournalRecord record;
+        std::size_t events = 0;
+        while (reader.next(record)) {
+            simulator.replay(record);
+            instruments.insert(record.order.instrument);
+            ++events;
+        }
+
+        std::cout << "[REPLAY] " << events << " events from " << journal << "\n";
+        if (!checkpoint.empty()) {
+            simulator.saveCheckpoint(checkpoint);
+            std::cout << "[REPLAY] Checkpoint written to " << checkpoint << "\n";
+        }
+        for (const auto& instrument : instruments) {
+            const TopOfBook top = simulator.getBook(instrument).topOfBook();
+            std::cout << "[REPLAY] " << instrument
+                      << " bid " << top.bid_price << " x " << top.bid_size
+                      << " / ask " << top.ask_price << " x " << top.ask_size << "\n";
+        }
+        return 0;
+    }
+
+    // backtests run on simulated time; live runs on the wall clock
+    // live strategies are hosted on a shared pool bounded by the core count
+    Simulator simulator(mode == "live" ? std::make_shared<RealTimeClock>() : nullptr,
+                        mode == "live" ? std::make_shared<ThreadPool>() : nullptr);
+    configure(simulator);
+    auto positions = std::make_shared<PositionKeeper>();
+    for (const auto& instrument : strategy_instruments) {
+        positions->addInstrument(instrument, &simulator.getBook(instrument));
+    }
+    positions->addAccount(SweepRunner::owner_id);
+    simulator.setPositionKeeper(positions);
+    if (!journal.empty()) {
+        simulator.setJournal(std::make_shared<JournalWriter>(journal));
+    }
+
+    std::shared_ptr<Strategy> strat = make_strategy(simulator, SweepParams{spread, size, max_loss});
+
+    simulator.registerStrategy(strat, SweepRunner::owner_id);
     simulator.start();
 
     MarketDataHandler md_handler(file);
-    md_handler.start([&](const Order& o) {
-        simulator.onOrder(o);
-        strat->onMarketData(o);
-    });
+    if (mode == "backtest") {
+        // replay as fast as possible; strategy timers fire between ticks in simulated time
+        md_handler.setOrderCallback([&](const Order& o) { simulator.onMarketData(o); });
+        md_handler.load();
+    } else {
+        // the feed thread only copies ticks into the bus; the engine matches them on its own thread
+        RingBuffer<Order> bus(4096);
+        BatchEventProcessor engine_stage(bus, {}, [&](Order& tick, int64_t, bool) {
+            simulator.onMarketData(tick);
+        });
+        bus.addGatingSequences({&engine_stage.sequence()});
+        std::thread engine_thread([&] { engine_stage.run(); });
 
-    while (running) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
+        md_handler.start([&](const Order& o) {
+            bus.publishEvent([&](Order& slot) { slot = o; });
+        });
+
+        while (running) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
 
-    md_handler.stop();
+        md_handler.stop();
+        bus.drain();
+        engine_stage.halt();
+        engine_thread.join();
+    }
     simulator.stop();
 
     strat->printSummary();
     strat->exportSummary("logs/summary.json");
 
+    // engine-side numbers, marked to the final mids and comparable across strategies
+    std::set<std::string> quote_currencies;
+    for (const auto& instrument : strategy_instruments) {
+        quote_currencies.insert(instrument.substr(instrument.find('-') + 1));
+    }
+    if (quote_currencies.size() == 1) {
+        AccountPnL pnl = positions->pnl(SweepRunner::owner_id);
+        std::cout << "[POSITIONS] Realized PnL: " << pnl.realized_pnl << "\n"
+                  << "[POSITIONS] Unrealized PnL: " << pnl.unrealized_pnl << "\n"
+                  << "[POSITIONS] Max Drawdown: " << pnl.max_drawdown << "\n";
+    } else {
+        // the keeper's totals would add up different currencies
+        std::cout << "[POSITIONS] Totals skipped: instruments are quoted in different currencies\n";
+    }
+    for (const auto& instrument : strategy_instruments) {
+        Position pos = positions->position(SweepRunner::owner_id, instrument);
+        std::cout << "[POSITIONS] " << instrument << ": " << pos.quantity
+                  << " @ " << pos.average_cost << " (mark " << pos.mark_price
+                  << ", realized " << pos.realized_pnl << ", unrealized " << pos.unrealized_pnl << ")\n";
+    }
+
     std::cout << "[ENGINE] Shutdown complete.\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+/**
+ * @file batch_indicators.cpp
+ * @brief Implements the batch indicator kernels and their run-time AVX2 dispatch.
+ */
+
+#include "core/batch_indicators.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TRADEIT_AVX2 1
+#define TRADEIT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace core::batch {
+
+namespace {
+
+bool cpuHasAvx2() {
+#ifdef TRADEIT_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+std::atomic<bool> use_simd{cpuHasAvx2()};
+
+void checkLengths(std::size_t in, std::size_t out) {
+    if (in != out) {
+        throw std::invalid_argument("Batch kernel output length must match its input");
+    }
+}
+
+struct Moments {
+    double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+
+    double correlation(std::size_t n) const {
+        double count = static_cast<double>(n);
+        double cov = sxy - sx * sy / count;
+        double vx = sxx - sx * sx / count;
+        double vy = syy - sy * sy / count;
+        return vx > 0.0 && vy > 0.0 ? cov / std::sqrt(vx * vy) : 0.0;
+    }
+};
+
+// Scalar reference versions
+
+namespace scalar {
+
+template <typename T>
+void rollingSum(const T* in, std::size_t n, std::size_t window, T* out) {
+    T sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += in[i];
+        if (i >= window) sum -= in[i - window];
+        out[i] = sum;
+    }
+}
+
+void ema(const double* in, std::size_t n, double alpha, double* out) {
+    double value = in[0];
+    out[0] = value;
+    for (std::size_t i = 1; i < n; ++i) {
+        value += alpha * (in[i] - value);
+        out[i] = value;
+    }
+}
+
+void ratios(const double* in, std::size_t n, double* out) {
+    for (std::size_t i = 1; i < n; ++i) out[i] = in[i] / in[i - 1];
+}
+
+Moments moments(const double* x, const double* y, std::size_t n) {
+    Moments m;
+    for (std::size_t i = 0; i < n; ++i) {
+        m.sx += x[i];
+        m.sy += y[i];
+        m.sxx += x[i] * x[i];
+        m.syy += y[i] * y[i];
+        m.sxy += x[i] * y[i];
+    }
+    return m;
+}
+
+}
+
+#ifdef TRADEIT_AVX2
+
+// AVX2 versions. Prefix sums are scanned inside each 4-wide register and
+// carried across registers, so the serial dependency is one add per 4 inputs.
+
+namespace avx2 {
+
+TRADEIT_TARGET_AVX2 inline __m256d shiftIn1(__m256d v) {
+    // [v0 v1 v2 v3] -> [0 v0 v1 v2]
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_pd(), 0b0001);
+}
+
+TRADEIT_TARGET_AVX2 inline __m256d shiftIn2(__m256d v) {
+    // [v0 v1 v2 v3] -> [0 0 v0 v1]
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_setzero_pd(), 0b0011);
+}
+
+TRADEIT_TARGET_AVX2 inline __m256i shiftIn1(__m256i v) {
+    return _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_si256(), 0b00000011);
+}
+
+TRADEIT_TARGET_AVX2 inline __m256i shiftIn2(__m256i v) {
+    return _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_setzero_si256(), 0b00001111);
+}
+
+// out = prefix sums of in; then out[i] -= out[i - window], back to front so
+// every subtrahend is still a prefix sum when it is read.
+TRADEIT_TARGET_AVX2 void rollingSum(const double* in, std::size_t n, std::size_t window, double* out) {
+    __m256d carry = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(in + i);
+        v = _mm256_add_pd(v, shiftIn1(v));
+        v = _mm256_add_pd(v, shiftIn2(v));
+        v = _mm256_add_pd(v, carry);
+        _mm256_storeu_pd(out + i, v);
+        carry = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    double sum = i > 0 ? out[i - 1] : 0.0;
+    for (; i < n; ++i) out[i] = sum += in[i];
+
+    std::size_t end = n;
+    for (; end >= window + 4; end -= 4) {
+        std::size_t at = end - 4;
+        _mm256_storeu_pd(out + at, _mm256_sub_pd(_mm256_loadu_pd(out + at), _mm256_loadu_pd(out + at - window)));
+    }
+    while (end > window) {
+        --end;
+        out[end] -= out[end - window];
+    }
+}
+
+TRADEIT_TARGET_AVX2 void rollingSum(const int64_t* in, std::size_t n, std::size_t window, int64_t* out) {
+    __m256i carry = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        v = _mm256_add_epi64(v, shiftIn1(v));
+        v = _mm256_add_epi64(v, shiftIn2(v));
+        v = _mm256_add_epi64(v, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        carry = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    int64_t sum = i > 0 ? out[i - 1] : 0;
+    for (; i < n; ++i) out[i] = sum += in[i];
+
+    std::size_t end = n;
+    for (; end >= window + 4; end -= 4) {
+        std::size_t at = end - 4;
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + at));
+        __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + at - window));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + at), _mm256_sub_epi64(cur, old));
+    }
+    while (end > window) {
+        --end;
+        out[end] -= out[end - window];
+    }
+}
+
+// y[t] = d * y[t-1] + a * x[t] with d = 1 - a, four steps per register:
+// scan a*x with weights d and d^2, then add d^(k+1) * y[t-1] to lane k.
+TRADEIT_TARGET_AVX2 void ema(const double* in, std::size_t n, double alpha, double* out) {
+    const double d = 1.0 - alpha;
+    const __m256d a = _mm256_set1_pd(alpha);
+    const __m256d d1 = _mm256_set1_pd(d);
+    const __m256d d2 = _mm256_set1_pd(d * d);
+    const __m256d powers = _mm256_setr_pd(d, d * d, d * d * d, d * d * d * d);
+
+    out[0] = in[0];
+    __m256d previous = _mm256_set1_pd(in[0]);
+    std::size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_mul_pd(a, _mm256_loadu_pd(in + i));
+        v = _mm256_add_pd(v, _mm256_mul_pd(d1, shiftIn1(v)));
+        v = _mm256_add_pd(v, _mm256_mul_pd(d2, shiftIn2(v)));
+        v = _mm256_add_pd(v, _mm256_mul_pd(powers, previous));
+        _mm256_storeu_pd(out + i, v);
+        previous = _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    double value = out[i - 1];
+    for (; i < n; ++i) out[i] = value += alpha * (in[i] - value);
+}
+
+TRADEIT_TARGET_AVX2 void ratios(const double* in, std::size_t n, double* out) {
+    std::size_t i = 1;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(in + i), _mm256_loadu_pd(in + i - 1)));
+    }
+    for (; i < n; ++i) out[i] = in[i] / in[i - 1];
+}
+
+TRADEIT_TARGET_AVX2 inline double horizontalSum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+TRADEIT_TARGET_AVX2 Moments moments(const double* x, const double* y, std::size_t n) {
+    __m256d sx = _mm256_setzero_pd(), sy = sx, sxx = sx, syy = sx, sxy = sx;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d vy = _mm256_loadu_pd(y + i);
+        sx = _mm256_add_pd(sx, vx);
+        sy = _mm256_add_pd(sy, vy);
+        sxx = _mm256_add_pd(sxx, _mm256_mul_pd(vx, vx));
+        syy = _mm256_add_pd(syy, _mm256_mul_pd(vy, vy));
+        sxy = _mm256_add_pd(sxy, _mm256_mul_pd(vx, vy));
+    }
+    Moments tail = scalar::moments(x + i, y + i, n - i);
+    return Moments{horizontalSum(sx) + tail.sx, horizontalSum(sy) + tail.sy, horizontalSum(sxx) + tail.sxx,
+                   horizontalSum(syy) + tail.syy, horizontalSum(sxy) + tail.sxy};
+}
+
+}
+
+#define TRADEIT_DISPATCH(call) (use_simd.load(std::memory_order_relaxed) ? avx2::call : scalar::call)
+#else
+#define TRADEIT_DISPATCH(call) (scalar::call)
+#endif
+
+Moments moments(const double* x, const double* y, std::size_t n) {
+    return TRADEIT_DISPATCH(moments(x, y, n));
+}
+
+}
+
+bool simdEnabled() {
+    return use_simd.load(std::memory_order_relaxed);
+}
+
+void setSimdEnabled(bool enabled) {
+    use_simd.store(enabled && cpuHasAvx2(), std::memory_order_relaxed);
+}
+
+void rollingSum(std::span<const double> in, std::size_t window, std::span<double> out) {
+    checkLengths(in.size(), out.size());
+    if (window == 0) throw std::invalid_argument("Rolling window must be positive");
+    TRADEIT_DISPATCH(rollingSum(in.data(), in.size(), window, out.data()));
+}
+
+void rollingSum(std::span<const int64_t> in, std::size_t window, std::span<int64_t> out) {
+    checkLengths(in.size(), out.size());
+    if (window == 0) throw std::invalid_argument("Rolling window must be positive");
+    TRADEIT_DISPATCH(rollingSum(in.data(), in.size(), window, out.data()));
+}
+
+void ema(std::span<const double> in, double alpha, std::span<double> out) {
+    checkLengths(in.size(), out.size());
+    if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("Ema alpha must be in (0, 1]");
+    if (in.empty()) return;
+    TRADEIT_DISPATCH(ema(in.data(), in.size(), alpha, out.data()));
+}
+
+void returns(std::span<const double> in, std::span<double> out) {
+    checkLengths(in.size(), out.size());
+    if (in.empty()) return;
+    TRADEIT_DISPATCH(ratios(in.data(), in.size(), out.data()));
+    out[0] = 0.0;
+    for (std::size_t i = 1; i < out.size(); ++i) out[i] -= 1.0;
+}
+
+void logReturns(std::span<const double> in, std::span<double> out) {
+    checkLengths(in.size(), out.size());
+    if (in.empty()) return;
+    TRADEIT_DISPATCH(ratios(in.data(), in.size(), out.data()));
+    out[0] = 0.0;
+    for (std::size_t i = 1; i < out.size(); ++i) out[i] = std::log(out[i]);
+}
+
+double correlation(std::span<const double> x, std::span<const double> y) {
+    checkLengths(x.size(), y.size());
+    if (x.empty()) return 0.0;
+    return moments(x.data(), y.data(), x.size()).correlation(x.size());
+}
+
+void crossCorrelation(std::span<const double> x, std::span<const double> y, std::span<double> out) {
+    checkLengths(x.size(), y.size());
+    for (std::size_t lag = 0; lag < out.size(); ++lag) {
+        out[lag] = lag < x.size() ? correlation(x.subspan(lag), y.first(y.size() - lag)) : 0.0;
+    }
+}
+
+}
@@ -0,0 +1,186 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implements the checkpoint writer and the memory-mapped checkpoint reader.
+ */
+
+#include "engine/checkpoint.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine {
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'R', 'D', 'C', 'K', 'P', 'T', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kAlignment = 8;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t book_count;
+    uint64_t journal_sequence;
+    uint64_t sim_time;
+    uint32_t strategy_count;
+    uint32_t reserved;
+};
+
+struct BookHeader {
+    uint64_t next_trade_id;
+    uint64_t top_sequence;
+    uint64_t order_count;
+    uint32_t instrument_length;
+    uint8_t phase;        ///< TradingPhase
+    uint8_t reserved[3];
+};
+
+struct StrategyHeader {
+    uint32_t name_length;
+    uint32_t state_length;
+};
+
+std::size_t aligned(std::size_t size) {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+void append(std::vector<char>& out, const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+    out.resize(aligned(out.size()), '\0');
+}
+
+}
+
+// CheckpointWriter
+
+CheckpointWriter::CheckpointWriter(uint64_t journal_sequence, uint64_t sim_time) {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.journal_sequence = journal_sequence;
+    header.sim_time = sim_time;
+    append(buffer_, &header, sizeof(header));
+}
+
+void CheckpointWriter::addBook(const std::string& instrument, const BookState& state) {
+    if (strategy_count_ > 0) {
+        throw std::logic_error("Checkpoint books must be added before strategies");
+    }
+    BookHeader header{state.next_trade_id, state.top_sequence, state.orders.size(),
+                      static_cast<uint32_t>(instrument.size()), static_cast<uint8_t>(state.phase), {}};
+    append(buffer_, &header, sizeof(header));
+    append(buffer_, instrument.data(), instrument.size());
+    append(buffer_, state.orders.data(), state.orders.size_bytes());
+    ++book_count_;
+}
+
+void CheckpointWriter::addStrategy(const std::string& name, const std::string& state) {
+    StrategyHeader header{static_cast<uint32_t>(name.size()), static_cast<uint32_t>(state.size())};
+    append(buffer_, &header, sizeof(header));
+    append(buffer_, name.data(), name.size());
+    append(buffer_, state.data(), state.size());
+    ++strategy_count_;
+}
+
+void CheckpointWriter::write(const std::string& path) {
+    auto* header = reinterpret_cast<FileHeader*>(buffer_.data());
+    header->book_count = book_count_;
+    header->strategy_count = strategy_count_;
+
+    // a crash mid-write leaves the previous checkpoint in place
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!out.flush()) {
+            throw std::runtime_error("Failed to write checkpoint file: " + tmp);
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace checkpoint file: " + path);
+    }
+}
+
+// MappedCheckpoint
+
+MappedCheckpoint::MappedCheckpoint(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open checkpoint file: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(fd);
+        throw std::runtime_error("Not a checkpoint file: " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to map checkpoint file: " + path);
+    }
+    data_ = static_cast<const char*>(mapped);
+
+    try {
+        std::size_t pos = 0;
+        auto take = [&](std::size_t size) {
+            if (size > size_ - pos) {
+                throw std::runtime_error("Truncated checkpoint file: " + path);
+            }
+            const char* at = data_ + pos;
+            pos = std::min(size_, aligned(pos + size));
+            return at;
+        };
+
+        const auto* header = reinterpret_cast<const FileHeader*>(take(sizeof(FileHeader)));
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("Not a checkpoint file: " + path);
+        }
+        if (header->version != kVersion) {
+            throw std::runtime_error("Unsupported checkpoint version " + std::to_string(header->version) + ": " + path);
+        }
+        journal_sequence_ = header->journal_sequence;
+        sim_time_ = header->sim_time;
+
+        books_.reserve(header->book_count);
+        for (uint32_t i = 0; i < header->book_count; ++i) {
+            const auto* book = reinterpret_cast<const BookHeader*>(take(sizeof(BookHeader)));
+            const char* instrument = take(book->instrument_length);
+            if (book->order_count > (size_ - pos) / sizeof(RestingOrder)) {
+                throw std::runtime_error("Truncated checkpoint file: " + path);
+            }
+            const auto* orders = reinterpret_cast<const RestingOrder*>(take(book->order_count * sizeof(RestingOrder)));
+            books_.push_back({std::string_view(instrument, book->instrument_length),
+                              BookState{book->next_trade_id, book->top_sequence,
+                                        static_cast<TradingPhase>(book->phase),
+                                        std::span<const RestingOrder>(orders, book->order_count)}});
+        }
+
+        strategies_.reserve(header->strategy_count);
+        for (uint32_t i = 0; i < header->strategy_count; ++i) {
+            const auto* strategy = reinterpret_cast<const StrategyHeader*>(take(sizeof(StrategyHeader)));
+            const char* name = take(strategy->name_length);
+            const char* state = take(strategy->state_length);
+            strategies_.push_back({std::string_view(name, strategy->name_length),
+                                   std::string_view(state, strategy->state_length)});
+        }
+    } catch (...) {
+        ::munmap(const_cast<char*>(data_), size_);
+        throw;
+    }
+}
+
+MappedCheckpoint::~MappedCheckpoint() {
+    ::munmap(const_cast<char*>(data_), size_);
+}
+
+}
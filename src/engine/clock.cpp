@@ -0,0 +1,171 @@
+/**
+ * @file clock.cpp
+ * @brief Implements the simulated and real-time clocks.
+ */
+
+#include "engine/clock.hpp"
+
+#include <chrono>
+
+namespace engine {
+
+TimerId TimerSet::add(uint64_t due, uint64_t interval, TimerCallback cb) {
+    TimerId id = next_id_++;
+    timers_.emplace(id, Timer{due, interval, std::move(cb)});
+    order_.emplace(due, id);
+    return id;
+}
+
+bool TimerSet::remove(TimerId id) {
+    auto it = timers_.find(id);
+    if (it == timers_.end()) return false;
+    order_.erase({it->second.due, id});
+    timers_.erase(it);
+    return true;
+}
+
+std::optional<uint64_t> TimerSet::nextDue() const {
+    if (order_.empty()) return std::nullopt;
+    return order_.begin()->first;
+}
+
+std::optional<std::tuple<TimerId, uint64_t, TimerCallback>> TimerSet::popDue(uint64_t limit) {
+    if (order_.empty() || order_.begin()->first > limit) return std::nullopt;
+
+    auto [due, id] = *order_.begin();
+    order_.erase(order_.begin());
+    // the timer stays registered while it fires so cancel() can still find it
+    return std::make_tuple(id, due, timers_.at(id).cb);
+}
+
+void TimerSet::rearm(TimerId id, uint64_t fired_at) {
+    auto it = timers_.find(id);
+    if (it == timers_.end()) return; // canceled while firing
+
+    if (it->second.interval == 0) {
+        timers_.erase(it);
+        return;
+    }
+    it->second.due = fired_at + it->second.interval;
+    order_.emplace(it->second.due, id);
+}
+
+void TimerSet::shift(uint64_t offset) {
+    order_.clear();
+    for (auto& [id, timer] : timers_) {
+        timer.due += offset;
+        order_.emplace(timer.due, id);
+    }
+}
+
+// SimulationClock
+
+TimerId SimulationClock::schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.add(now() + delay_us, interval_us, std::move(cb));
+}
+
+void SimulationClock::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    timers_.remove(id);
+}
+
+void SimulationClock::advanceTo(uint64_t ts) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!started_) {
+        // timers armed before replay are relative to the first event
+        started_ = true;
+        timers_.shift(ts);
+        now_.store(ts, std::memory_order_release);
+    }
+
+    while (auto next = timers_.popDue(ts)) {
+        auto& [id, due, cb] = *next;
+        if (due > now()) now_.store(due, std::memory_order_release);
+
+        lock.unlock();
+        cb();
+        lock.lock();
+
+        timers_.rearm(id, due);
+    }
+
+    if (ts > now()) now_.store(ts, std::memory_order_release);
+}
+
+std::optional<uint64_t> SimulationClock::nextTimerDue() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.nextDue();
+}
+
+// RealTimeClock
+
+RealTimeClock::~RealTimeClock() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint64_t RealTimeClock::now() const {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+TimerId RealTimeClock::schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TimerId id = timers_.add(now() + delay_us, interval_us, std::move(cb));
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&RealTimeClock::run, this);
+    }
+    cv_.notify_all();
+    return id;
+}
+
+void RealTimeClock::cancel(TimerId id) {
+    if (id == 0) return;  // also the "nothing firing" value of firing_
+    std::unique_lock<std::mutex> lock(mutex_);
+    timers_.remove(id);
+    if (std::this_thread::get_id() != worker_.get_id()) {
+        cv_.wait(lock, [&] { return firing_ != id; });
+    }
+}
+
+void RealTimeClock::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        auto next_due = timers_.nextDue();
+        if (!next_due) {
+            cv_.wait(lock);
+            continue;
+        }
+
+        uint64_t current = now();
+        if (*next_due > current) {
+            cv_.wait_for(lock, std::chrono::microseconds(*next_due - current));
+            continue;
+        }
+
+        auto next = timers_.popDue(current);
+        if (!next) continue;
+        [[maybe_unused]] auto& [id, due, cb] = *next;
+
+        firing_ = id;
+        lock.unlock();
+        cb();
+        lock.lock();
+        firing_ = 0;
+
+        // like a sleep loop, the next period starts when this call returns
+        timers_.rearm(id, now());
+        cv_.notify_all();
+    }
+}
+
+}
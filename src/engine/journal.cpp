@@ -0,0 +1,199 @@
+/**
+ * @file journal.cpp
+ * @brief Implements the batched journal writer and the journal reader.
+ */
+
+#include "engine/journal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace engine {
+
+using namespace core;
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'R', 'D', 'J', 'R', 'N', 'L', '\0'};
+constexpr uint32_t kVersion = 1;
+
+template <typename T>
+void put(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool get(const std::vector<char>& in, std::size_t& pos, T& value) {
+    if (pos + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+}
+
+// JournalWriter
+
+JournalWriter::JournalWriter(const std::string& path, std::size_t batch_bytes, uint64_t flush_interval_us)
+    : out_(path, std::ios::binary | std::ios::trunc),
+      batch_bytes_(batch_bytes),
+      flush_interval_us_(flush_interval_us) {
+    if (!out_.is_open()) {
+        throw std::runtime_error("Failed to open journal file: " + path);
+    }
+    out_.write(kMagic, sizeof(kMagic));
+    out_.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    pending_.reserve(batch_bytes_);
+    worker_ = std::thread(&JournalWriter::run, this);
+}
+
+JournalWriter::~JournalWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint64_t JournalWriter::append(JournalEvent event, uint64_t sim_time, const Order& order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t sequence = next_sequence_++;
+
+    // length placeholder, patched once the record is encoded
+    std::size_t start = pending_.size();
+    put<uint32_t>(pending_, 0);
+    put(pending_, sequence);
+    put(pending_, sim_time);
+    put(pending_, static_cast<uint8_t>(event));
+    put(pending_, order.id);
+    put(pending_, static_cast<uint8_t>(order.type));
+    put(pending_, static_cast<uint8_t>(order.side));
+    put(pending_, order.price);
+    put(pending_, order.quantity);
+    put(pending_, order.display_quantity);
+    put(pending_, order.timestamp);
+    put(pending_, order.owner_id);
+    put(pending_, static_cast<uint16_t>(order.instrument.size()));
+    pending_.insert(pending_.end(), order.instrument.begin(), order.instrument.end());
+
+    uint32_t length = static_cast<uint32_t>(pending_.size() - start - sizeof(uint32_t));
+    std::memcpy(pending_.data() + start, &length, sizeof(length));
+
+    if (pending_.size() >= batch_bytes_) {
+        wake_.notify_one();
+    }
+    return sequence;
+}
+
+void JournalWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_target_ = std::max(flush_target_, next_sequence_);
+    wake_.notify_one();
+    written_.wait(lock, [this] { return durable_ >= flush_target_; });
+}
+
+void JournalWriter::run() {
+    std::vector<char> writing;
+    writing.reserve(batch_bytes_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait_for(lock, std::chrono::microseconds(flush_interval_us_), [this] {
+            return stopping_ || pending_.size() >= batch_bytes_ || durable_ < flush_target_;
+        });
+
+        if (!pending_.empty()) {
+            writing.swap(pending_);
+            uint64_t upto = next_sequence_;
+
+            // appends continue into the other buffer while this one is written
+            lock.unlock();
+            out_.write(writing.data(), static_cast<std::streamsize>(writing.size()));
+            out_.flush();
+            writing.clear();
+            lock.lock();
+
+            durable_ = upto;
+            written_.notify_all();
+        }
+
+        if (stopping_ && pending_.empty()) return;
+    }
+}
+
+// JournalReader
+
+JournalReader::JournalReader(const std::string& path) : in_(path, std::ios::binary) {
+    if (!in_.is_open()) {
+        throw std::runtime_error("Failed to open journal file: " + path);
+    }
+
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    in_.read(magic, sizeof(magic));
+    in_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in_ || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a journal file: " + path);
+    }
+    if (version != kVersion) {
+        throw std::runtime_error("Unsupported journal version " + std::to_string(version) + ": " + path);
+    }
+}
+
+bool JournalReader::next(JournalRecord& record) {
+    uint32_t length = 0;
+    if (!in_.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+
+    buffer_.resize(length);
+    if (!in_.read(buffer_.data(), length)) return false;
+
+    std::size_t pos = 0;
+    uint8_t event = 0, type = 0, side = 0;
+    uint16_t instrument_length = 0;
+    Order& order = record.order;
+    bool ok = get(buffer_, pos, record.sequence) &&
+              get(buffer_, pos, record.sim_time) &&
+              get(buffer_, pos, event) &&
+              get(buffer_, pos, order.id) &&
+              get(buffer_, pos, type) &&
+              get(buffer_, pos, side) &&
+              get(buffer_, pos, order.price) &&
+              get(buffer_, pos, order.quantity) &&
+              get(buffer_, pos, order.display_quantity) &&
+              get(buffer_, pos, order.timestamp) &&
+              get(buffer_, pos, order.owner_id) &&
+              get(buffer_, pos, instrument_length) &&
+              pos + instrument_length <= buffer_.size();
+    if (!ok) return false;
+
+    order.instrument.assign(buffer_.data() + pos, instrument_length);
+    record.event = static_cast<JournalEvent>(event);
+    order.type = static_cast<OrderType>(type);
+    order.side = static_cast<Side>(side);
+    return true;
+}
+
+bool JournalReader::skipTo(uint64_t sequence) {
+    while (true) {
+        std::streampos start = in_.tellg();
+        uint32_t length = 0;
+        uint64_t current = 0;
+        if (!in_.read(reinterpret_cast<char*>(&length), sizeof(length)) || length < sizeof(current) ||
+            !in_.read(reinterpret_cast<char*>(&current), sizeof(current))) {
+            return false;
+        }
+        if (current >= sequence) {
+            in_.seekg(start);
+            return true;
+        }
+        in_.seekg(length - sizeof(current), std::ios::cur);
+    }
+}
+
+}
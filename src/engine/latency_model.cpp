@@ -0,0 +1,37 @@
+/**
+ * @file latency_model.cpp
+ * @brief Implements the sampled and per-instrument latency models.
+ */
+
+#include "engine/latency_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+LogNormalLatency::LogNormalLatency(double median_us, double sigma, uint64_t min_us, uint64_t seed)
+    : rng_(seed),
+      dist_(std::log(std::max(median_us, 1.0)), sigma),
+      min_us_(min_us) {}
+
+uint64_t LogNormalLatency::sample(const std::string&) {
+    return std::max(min_us_, static_cast<uint64_t>(std::llround(dist_(rng_))));
+}
+
+PerInstrumentLatency::PerInstrumentLatency(std::unique_ptr<LatencyModel> fallback)
+    : fallback_(std::move(fallback)) {}
+
+void PerInstrumentLatency::set(const std::string& instrument, std::unique_ptr<LatencyModel> model) {
+    models_[instrument] = std::move(model);
+}
+
+uint64_t PerInstrumentLatency::sample(const std::string& instrument) {
+    auto it = models_.find(instrument);
+    if (it != models_.end()) {
+        return it->second->sample(instrument);
+    }
+    return fallback_ ? fallback_->sample(instrument) : 0;
+}
+
+}
@@ -22,6 +22,7 @@ void MarketDataHandler::setOrderCallback(OrderCallback cb) {
 }
 
 void MarketDataHandler::start(OrderCallback callback) {
+    if (callback) callback_ = callback;
     running_ = true;
     worker_ = std::thread(&MarketDataHandler::feedLoop, this, callback);
 }
@@ -89,6 +90,16 @@ void MarketDataHandler::feedLoop(OrderCallback callback) {
 }
 
 void MarketDataHandler::load() {
+    readFile(callback_);
+}
+
+std::vector<Order> MarketDataHandler::loadOrders() {
+    std::vector<Order> orders;
+    readFile([&](Order order) { orders.push_back(std::move(order)); });
+    return orders;
+}
+
+void MarketDataHandler::readFile(const OrderCallback& sink) {
     std::ifstream infile(file_path_);
     if (!infile.is_open()) {
         throw std::runtime_error("Failed to open market data file: " + file_path_);
@@ -118,7 +129,7 @@ void MarketDataHandler::load() {
 
         try {
             Order order = parseLine(line);
-            if (callback_) callback_(order);
+            if (sink) sink(order);
         } catch (const std::exception& ex) {
             std::cerr << "Load error: " << ex.what() << "\n";
         }
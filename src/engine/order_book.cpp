@@ -7,194 +7,353 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace engine {
 
 using namespace core;
 
-OrderBook::OrderBook(const std::string& instrument)
-    : instrument_(instrument) {}
+template <typename MatchingPolicy>
+BasicOrderBook<MatchingPolicy>::BasicOrderBook(const std::string& instrument, SelfTradePrevention stp)
+    : instrument_(instrument), stp_mode_(stp) {}
 
 /**
  * Add an order to the book and return any resulting trades.
  */
-std::vector<Trade> OrderBook::addOrder(const Order& order) {
+template <typename MatchingPolicy>
+std::vector<Trade> BasicOrderBook<MatchingPolicy>::addOrder(const Order& order) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (order.type == OrderType::MARKET || 
-        (order.type == OrderType::LIMIT &&
-        ((order.side == Side::BUY && !asks_.empty() && order.price >= asks_.begin()->first) ||
-        (order.side == Side::SELL && !bids_.empty() && order.price <= bids_.begin()->first)))) {
-        
-        auto trades = match(order);
+    Order incoming = order;
+    std::vector<Trade> trades;
 
-        if (trade_callback_) {
-            for (const auto& t : trades) {
-                trade_callback_(t);
-            }
-        }
+    if (phase_ == TradingPhase::AUCTION) {
+        // a zero quantity is a cancel-by-resubmit and must not touch the live order
+        if (incoming.quantity == 0) return trades;
 
+        // collected for the uncross; the book may cross in the meantime
+        if (incoming.type == OrderType::LIMIT) {
+            insertLimitOrder(incoming);
+        } else {
+            (incoming.side == Side::BUY ? auction_buys_ : auction_sells_).push_back(incoming);
+        }
+        std::cout << "[OrderBook] Auction "
+                  << (incoming.side == Side::BUY ? "BUY" : "SELL")
+                  << " order ID " << incoming.id
+                  << " @ " << incoming.price
+                  << " x " << incoming.quantity << std::endl;
+        publishTopOfBook();
         return trades;
     }
 
-    if (order.type == OrderType::LIMIT) {
-        insertLimitOrder(order);
-        std::cout << "[OrderBook] Added " 
-                  << (order.side == Side::BUY ? "BUY" : "SELL")
-                  << " order ID " << order.id
-                  << " @ " << order.price
-                  << " x " << order.quantity << std::endl;
+    if (incoming.side == Side::BUY) {
+        match<Side::BUY>(incoming, trades);
+    } else {
+        match<Side::SELL>(incoming, trades);
     }
 
-    return {};
+    if (trade_callback_) {
+        for (const auto& t : trades) {
+            trade_callback_(t);
+        }
+    }
+
+    // any unfilled limit quantity rests at its limit price
+    if (incoming.type == OrderType::LIMIT && incoming.quantity > 0) {
+        insertLimitOrder(incoming);
+        std::cout << "[OrderBook] Added "
+                  << (incoming.side == Side::BUY ? "BUY" : "SELL")
+                  << " order ID " << incoming.id
+                  << " @ " << incoming.price
+                  << " x " << incoming.quantity << std::endl;
+    }
+
+    publishTopOfBook();
+    return trades;
 }
 
 /**
- * Match an order against the opposing side of the book.
+ * Match an order against the opposing side of the book, best level first.
  */
-std::vector<Trade> OrderBook::match(const Order& order) {
-    std::vector<Trade> trades;
+template <typename MatchingPolicy>
+template <Side S>
+void BasicOrderBook<MatchingPolicy>::match(Order& order, std::vector<Trade>& trades) {
+    auto& levels = SideTraits<S>::opposite(*this);
+
+    while (!levels.empty() && order.quantity > 0) {
+        auto price_level = levels.begin();
+        double match_price = price_level->first;
+        auto& level = price_level->second;
+
+        if (order.type == OrderType::LIMIT && !SideTraits<S>::crosses(order.price, match_price)) break;
+
+        if constexpr (MatchingPolicy::pro_rata) {
+            matchProRata<S>(order, match_price, level, trades);
+        } else {
+            matchFifo<S>(order, match_price, level, trades);
+        }
 
-    if (order.side == Side::BUY) {
-        // match against asks
-        while (!asks_.empty() && order.quantity > 0) {
-            auto price_level = asks_.begin();
-            double match_price = price_level->first;
-            auto& queue = price_level->second;
-
-            while (!queue.empty() && order.quantity > 0) {
-                Order resting = queue.front();
-                uint32_t traded_qty = std::min(order.quantity, resting.quantity);
-
-                Trade trade(
-                    next_trade_id_++,
-                    order.id,
-                    resting.id,
-                    instrument_,
-                    match_price,
-                    traded_qty,
-                    order.timestamp,
-                    Side::BUY
-                );
-                trades.push_back(trade);
-
-                std::cout << "[OrderBook] Trade executed: "
-                          << "Trade ID " << trade.trade_id
-                          << ", Buy ID " << trade.buy_order_id
-                          << ", Sell ID " << trade.sell_order_id
-                          << ", Price " << trade.price
-                          << ", Quantity " << trade.quantity << std::endl;
-
-                // update or remove resting order
-                if (traded_qty == resting.quantity) {
-                    queue.pop_front();
-                    orders_.erase(resting.id);
-                } else {
-                    queue.front().quantity -= traded_qty;
-                }
-
-                // reduce incoming order quantity
-                const_cast<Order&>(order).quantity -= traded_qty;
-            }
+        if (level.orders.empty()) {
+            levels.erase(price_level);
+        }
+    }
+}
 
-            if (queue.empty()) {
-                asks_.erase(price_level);
-            }
+/**
+ * Price-time priority within one level.
+ */
+template <typename MatchingPolicy>
+template <Side S>
+void BasicOrderBook<MatchingPolicy>::matchFifo(Order& order, double price, PriceLevel& level,
+                                               std::vector<Trade>& trades) {
+    while (!level.orders.empty() && order.quantity > 0) {
+        Order& resting = level.orders.front();
+        execute<S>(order, resting, std::min(order.quantity, resting.quantity), price, level, trades);
+
+        if (resting.quantity == 0) {
+            popFilled(level, order.timestamp);
         }
-    } else {
-        // match against bids
-        while (!bids_.empty() && order.quantity > 0) {
-            auto price_level = bids_.begin();
-            double match_price = price_level->first;
-            auto& queue = price_level->second;
-
-            while (!queue.empty() && order.quantity > 0) {
-                Order resting = queue.front();
-                uint32_t traded_qty = std::min(order.quantity, resting.quantity);
-
-                Trade trade(
-                    next_trade_id_++,
-                    resting.id,
-                    order.id,
-                    instrument_,
-                    match_price,
-                    traded_qty,
-                    order.timestamp,
-                    Side::SELL
-                );
-                trades.push_back(trade);
-
-                std::cout << "[OrderBook] Trade executed: "
-                          << "Trade ID " << trade.trade_id
-                          << ", Buy ID " << trade.buy_order_id
-                          << ", Sell ID " << trade.sell_order_id
-                          << ", Price " << trade.price
-                          << ", Quantity " << trade.quantity << std::endl;
-
-                // update or remove resting order
-                if (traded_qty == resting.quantity) {
-                    queue.pop_front();
-                    orders_.erase(resting.id);
-                } else {
-                    queue.front().quantity -= traded_qty;
-                }
-
-                // reduce incoming order quantity (note: order is const so we can't modify it directly)
-                const_cast<Order&>(order).quantity -= traded_qty;
-            }
+    }
+}
 
-            if (queue.empty()) {
-                bids_.erase(price_level);
-            }
+/**
+ * Pro-rata allocation within one level (optionally after filling the top order).
+ */
+template <typename MatchingPolicy>
+template <Side S>
+void BasicOrderBook<MatchingPolicy>::matchProRata(Order& order, double price, PriceLevel& level,
+                                                  std::vector<Trade>& trades) {
+    auto& queue = level.orders;
+
+    if constexpr (MatchingPolicy::top_order_priority) {
+        Order& top = queue.front();
+        execute<S>(order, top, std::min(order.quantity, top.quantity), price, level, trades);
+        if (top.quantity == 0) {
+            popFilled(level, order.timestamp);
         }
+        if (order.quantity == 0 || queue.empty()) return;
     }
 
-    return trades;
+    // everyone at the level fills completely, allocation order does not matter
+    if (order.quantity >= level.quantity) {
+        matchFifo<S>(order, price, level, trades);
+        return;
+    }
+
+    // proportional shares, rounded down
+    const uint64_t incoming_qty = order.quantity;
+    const uint64_t level_qty = level.quantity;
+    for (auto& resting : queue) {
+        if (order.quantity == 0) break;
+        uint32_t share = static_cast<uint32_t>(resting.quantity * incoming_qty / level_qty);
+        if (share == 0) continue;
+        execute<S>(order, resting, share, price, level, trades);
+    }
+
+    // rounding leftovers in arrival order
+    for (auto& resting : queue) {
+        if (order.quantity == 0) break;
+        if (resting.quantity == 0) continue;
+        execute<S>(order, resting, std::min(order.quantity, resting.quantity), price, level, trades);
+    }
+
+    // compact out emptied orders, keeping arrival order of the rest
+    filled_scratch_.clear();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        if (queue[i].quantity > 0) {
+            if (kept != i) queue[kept] = std::move(queue[i]);
+            ++kept;
+        } else {
+            filled_scratch_.push_back(std::move(queue[i]));
+        }
+    }
+    queue.resize(kept);
+    for (const auto& filled : filled_scratch_) {
+        releaseFilled(filled, level, order.timestamp);
+    }
+}
+
+/**
+ * Routes one resting order through self-trade prevention or a fill.
+ */
+template <typename MatchingPolicy>
+template <Side S>
+void BasicOrderBook<MatchingPolicy>::execute(Order& order, Order& resting, uint32_t qty, double price,
+                                             PriceLevel& level, std::vector<Trade>& trades) {
+    uint32_t before = resting.quantity;
+
+    if (isSelfTrade(order, resting)) {
+        preventSelfTrade(order, resting, qty);
+    } else {
+        fill<S>(order, resting, qty, price, trades);
+    }
+
+    level.quantity -= before - resting.quantity;
+}
+
+/**
+ * Executes a fill between the incoming and a resting order.
+ */
+template <typename MatchingPolicy>
+template <Side S>
+void BasicOrderBook<MatchingPolicy>::fill(Order& order, Order& resting, uint32_t qty, double price,
+                                          std::vector<Trade>& trades) {
+    Trade trade(
+        next_trade_id_++,
+        S == Side::BUY ? order.id : resting.id,
+        S == Side::BUY ? resting.id : order.id,
+        instrument_,
+        price,
+        qty,
+        order.timestamp,
+        S
+    );
+    trade.buy_owner_id = S == Side::BUY ? order.owner_id : resting.owner_id;
+    trade.sell_owner_id = S == Side::BUY ? resting.owner_id : order.owner_id;
+    trades.push_back(trade);
+
+    std::cout << "[OrderBook] Trade executed: "
+              << "Trade ID " << trade.trade_id
+              << ", Buy ID " << trade.buy_order_id
+              << ", Sell ID " << trade.sell_order_id
+              << ", Price " << trade.price
+              << ", Quantity " << trade.quantity << std::endl;
+
+    resting.quantity -= qty;
+    order.quantity -= qty;
+
+    // fully filled orders are dropped from orders_ when they leave the queue
+    if (resting.quantity > 0) {
+        orders_[resting.id].quantity = resting.quantity;
+    }
 }
 
 /**
  * Inserts a passive limit order into the book.
  */
-void OrderBook::insertLimitOrder(const Order& order) {
-    if (order.side == Side::BUY) {
-        bids_[order.price].push_back(order);
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::insertLimitOrder(const Order& order) {
+    Order resting = order;
+    if (order.isIceberg()) {
+        // show one clip, keep the rest hidden
+        resting.quantity = order.display_quantity;
+        iceberg_reserve_[order.id] = order.quantity - order.display_quantity;
     } else {
-        asks_[order.price].push_back(order);
+        resting.display_quantity = 0;
     }
-    orders_[order.id] = order;
+
+    PriceLevel& level = (resting.side == Side::BUY) ? bids_[resting.price] : asks_[resting.price];
+    level.orders.push_back(resting);
+    level.quantity += resting.quantity;
+    orders_[resting.id] = resting;
 }
 
 /**
- * Cancel a resting limit order by ID.
+ * Pops a fully filled resting order off the front of its level.
  */
-bool OrderBook::cancelOrder(uint64_t order_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::popFilled(PriceLevel& level, uint64_t ts) {
+    Order filled = level.orders.front();
+    level.orders.pop_front();
+    releaseFilled(filled, level, ts);
+}
 
-    // Search bids_
-    for (auto bid_it = bids_.begin(); bid_it != bids_.end(); ++bid_it) {
-        auto& queue = bid_it->second;
-        for (auto q_it = queue.begin(); q_it != queue.end(); ++q_it) {
-            if (q_it->id == order_id) {
-                queue.erase(q_it);
-                if (queue.empty()) bids_.erase(bid_it);
-                orders_.erase(order_id);
-                std::cout << "[OrderBook] Canceled order ID " << order_id << std::endl;
-                return true;
+/**
+ * Re-queues the next iceberg clip at the back of the level, or forgets the order.
+ */
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::releaseFilled(const Order& filled, PriceLevel& level, uint64_t ts) {
+    if (filled.display_quantity != 0) {
+        auto it = iceberg_reserve_.find(filled.id);
+        if (it != iceberg_reserve_.end()) {
+            Order clip = filled;
+            clip.quantity = std::min(filled.display_quantity, it->second);
+            clip.timestamp = ts;
+            it->second -= clip.quantity;
+            if (it->second == 0) {
+                iceberg_reserve_.erase(it);
+                clip.display_quantity = 0; // last clip behaves like a plain order
             }
+            level.orders.push_back(clip);
+            level.quantity += clip.quantity;
+            orders_[clip.id] = clip;
+            return;
         }
     }
 
-    // search asks
-    for (auto ask_it = asks_.begin(); ask_it != asks_.end(); ++ask_it) {
-        auto& queue = ask_it->second;
-        for (auto q_it = queue.begin(); q_it != queue.end(); ++q_it) {
-            if (q_it->id == order_id) {
-                queue.erase(q_it);
-                if (queue.empty()) asks_.erase(ask_it);
-                orders_.erase(order_id);
-                std::cout << "[OrderBook] Canceled order ID " << order_id << std::endl;
-                return true;
+    orders_.erase(filled.id);
+}
+
+/**
+ * Drops a resting order without a fill.
+ */
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::cancelResting(Order& resting) {
+    if (resting.display_quantity != 0) iceberg_reserve_.erase(resting.id);
+    orders_.erase(resting.id);
+    std::cout << "[OrderBook] Self-trade prevention canceled order ID " << resting.id << std::endl;
+    resting.quantity = 0;
+    resting.display_quantity = 0;
+}
+
+/**
+ * Resolves a would-be self-trade between the incoming order and a resting order.
+ */
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::preventSelfTrade(Order& order, Order& resting, uint32_t overlap) {
+    switch (stp_mode_) {
+        case SelfTradePrevention::CANCEL_NEWEST:
+            order.quantity = 0;
+            break;
+        case SelfTradePrevention::CANCEL_OLDEST:
+            cancelResting(resting);
+            break;
+        case SelfTradePrevention::CANCEL_BOTH:
+            cancelResting(resting);
+            order.quantity = 0;
+            break;
+        case SelfTradePrevention::DECREMENT:
+            order.quantity -= overlap;
+            resting.quantity -= overlap;
+            if (resting.quantity > 0) {
+                orders_[resting.id].quantity = resting.quantity;
             }
+            break;
+        case SelfTradePrevention::NONE:
+            break;
+    }
+}
+
+/**
+ * Cancel a resting limit order by ID.
+ */
+template <typename MatchingPolicy>
+bool BasicOrderBook<MatchingPolicy>::cancelOrder(uint64_t order_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = orders_.find(order_id);
+    if (it != orders_.end()) {
+        const Order& resting = it->second;
+        bool erased = (resting.side == Side::BUY)
+            ? eraseResting(bids_, order_id, resting.price)
+            : eraseResting(asks_, order_id, resting.price);
+        if (erased) {
+            orders_.erase(it);
+            publishTopOfBook();
+            std::cout << "[OrderBook] Canceled order ID " << order_id << std::endl;
+            return true;
+        }
+    }
+
+    for (auto* queue : {&auction_buys_, &auction_sells_}) {
+        auto waiting = std::find_if(queue->begin(), queue->end(), [&](const Order& o) { return o.id == order_id; });
+        if (waiting != queue->end()) {
+            queue->erase(waiting);
+            std::cout << "[OrderBook] Canceled order ID " << order_id << std::endl;
+            return true;
         }
     }
 
@@ -202,7 +361,30 @@ bool OrderBook::cancelOrder(uint64_t order_id) {
     return false;
 }
 
-const std::unordered_map<uint64_t, core::Order>& OrderBook::getOrders() const {
+/**
+ * Removes an order from the level at its price, dropping the level if it empties.
+ */
+template <typename MatchingPolicy>
+template <typename Levels>
+bool BasicOrderBook<MatchingPolicy>::eraseResting(Levels& levels, uint64_t order_id, double price) {
+    auto level_it = levels.find(price);
+    if (level_it == levels.end()) return false;
+
+    auto& level = level_it->second;
+    for (auto q_it = level.orders.begin(); q_it != level.orders.end(); ++q_it) {
+        if (q_it->id == order_id) {
+            if (q_it->display_quantity != 0) iceberg_reserve_.erase(order_id);
+            level.quantity -= q_it->quantity;
+            level.orders.erase(q_it);
+            if (level.orders.empty()) levels.erase(level_it);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename MatchingPolicy>
+const std::unordered_map<uint64_t, core::Order>& BasicOrderBook<MatchingPolicy>::getOrders() const {
     return orders_;
 }
 
@@ -210,42 +392,383 @@ const std::unordered_map<uint64_t, core::Order>& OrderBook::getOrders() const {
 /**
  * Prints a snapshot of the order book to stdout.
  */
-void OrderBook::printBook() const {
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::printBook() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
     std::cout << "Order Book [" << instrument_ << "]\n";
 
     std::cout << "  Asks:\n";
-    for (const auto& [price, queue] : asks_) {
-        std::cout << "    " << std::fixed << std::setprecision(2) << price << " × " << queue.size() << "\n";
+    for (const auto& [price, level] : asks_) {
+        std::cout << "    " << std::fixed << std::setprecision(2) << price << " × " << level.quantity
+                  << " (" << level.orderCount() << " orders)\n";
     }
 
     std::cout << "  Bids:\n";
-    for (const auto& [price, queue] : bids_) {
-        std::cout << "    " << std::fixed << std::setprecision(2) << price << " × " << queue.size() << "\n";
+    for (const auto& [price, level] : bids_) {
+        std::cout << "    " << std::fixed << std::setprecision(2) << price << " × " << level.quantity
+                  << " (" << level.orderCount() << " orders)\n";
     }
 }
 
 // Implementation for getBestBid and getBestAsk
 
-std::optional<Order> OrderBook::getBestBid() const {
+template <typename MatchingPolicy>
+std::optional<Order> BasicOrderBook<MatchingPolicy>::getBestBid() const {
     std::lock_guard<std::mutex> lock(mutex_);
     if (bids_.empty()) return std::nullopt;
-    const auto& queue = bids_.begin()->second;
+    const auto& queue = bids_.begin()->second.orders;
     if (queue.empty()) return std::nullopt;
     return queue.front();
 }
 
-std::optional<Order> OrderBook::getBestAsk() const {
+template <typename MatchingPolicy>
+std::optional<Order> BasicOrderBook<MatchingPolicy>::getBestAsk() const {
     std::lock_guard<std::mutex> lock(mutex_);
     if (asks_.empty()) return std::nullopt;
-    const auto& queue = asks_.begin()->second;
+    const auto& queue = asks_.begin()->second.orders;
     if (queue.empty()) return std::nullopt;
     return queue.front();
 }
 
-void OrderBook::setTradeCallback(std::function<void(const Trade&)> cb) {
+template <typename MatchingPolicy>
+TopOfBook BasicOrderBook<MatchingPolicy>::currentTop() const {
+    TopOfBook top;
+    if (!bids_.empty()) {
+        top.bid_price = bids_.begin()->first;
+        top.bid_size = bids_.begin()->second.quantity;
+    }
+    if (!asks_.empty()) {
+        top.ask_price = asks_.begin()->first;
+        top.ask_size = asks_.begin()->second.quantity;
+    }
+    return top;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::publishTopOfBook() {
+    TopOfBook top = currentTop();
+
+    if (top.bid_price == last_top_.bid_price && top.bid_size == last_top_.bid_size &&
+        top.ask_price == last_top_.ask_price && top.ask_size == last_top_.ask_size) {
+        return;
+    }
+
+    top.sequence = last_top_.sequence + 1;
+    last_top_ = top;
+    top_of_book_.store(top);
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::depthSnapshot(std::size_t levels, DepthSnapshot& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    out.bids.clear();
+    out.asks.clear();
+
+    for (auto it = bids_.begin(); it != bids_.end() && out.bids.size() < levels; ++it) {
+        out.bids.push_back({it->first, it->second.quantity, it->second.orderCount()});
+    }
+    for (auto it = asks_.begin(); it != asks_.end() && out.asks.size() < levels; ++it) {
+        out.asks.push_back({it->first, it->second.quantity, it->second.orderCount()});
+    }
+}
+
+template <typename MatchingPolicy>
+uint64_t BasicOrderBook<MatchingPolicy>::levelQuantity(Side side, double price) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (side == Side::BUY) {
+        auto it = bids_.find(price);
+        return it == bids_.end() ? 0 : it->second.quantity;
+    }
+    auto it = asks_.find(price);
+    return it == asks_.end() ? 0 : it->second.quantity;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::startAuction() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    phase_ = TradingPhase::AUCTION;
+}
+
+template <typename MatchingPolicy>
+TradingPhase BasicOrderBook<MatchingPolicy>::phase() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phase_;
+}
+
+template <typename MatchingPolicy>
+std::optional<AuctionQuote> BasicOrderBook<MatchingPolicy>::indicativeUncross(std::optional<double> reference) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return equilibrium(reference);
+}
+
+template <typename MatchingPolicy>
+uint64_t BasicOrderBook<MatchingPolicy>::auctionQuantity(const PriceLevel& level) const {
+    uint64_t total = level.quantity;
+    for (const auto& o : level.orders) {
+        if (o.display_quantity == 0) continue;
+        auto it = iceberg_reserve_.find(o.id);
+        if (it != iceberg_reserve_.end()) total += it->second;
+    }
+    return total;
+}
+
+/**
+ * Finds the price maximizing min(demand, supply) over the crossed price range.
+ */
+template <typename MatchingPolicy>
+std::optional<AuctionQuote> BasicOrderBook<MatchingPolicy>::equilibrium(std::optional<double> reference) const {
+    uint64_t market_buy = 0, market_sell = 0;
+    for (const auto& o : auction_buys_) market_buy += o.quantity;
+    for (const auto& o : auction_sells_) market_sell += o.quantity;
+    if ((bids_.empty() && market_buy == 0) || (asks_.empty() && market_sell == 0)) return std::nullopt;
+
+    // market orders take any price, so they open the range on their side
+    const double highest = market_buy > 0 || bids_.empty() ? std::numeric_limits<double>::infinity() : bids_.begin()->first;
+    const double lowest = market_sell > 0 || asks_.empty() ? -std::numeric_limits<double>::infinity() : asks_.begin()->first;
+    if (lowest > highest) return std::nullopt;
+
+    // candidate prices: every level inside the crossed range, ascending
+    std::vector<double> prices;
+    for (auto it = asks_.begin(); it != asks_.end() && it->first <= highest; ++it) {
+        prices.push_back(it->first);
+    }
+    std::size_t ask_count = prices.size();
+    for (auto it = bids_.begin(); it != bids_.end() && it->first >= lowest; ++it) {
+        prices.push_back(it->first);
+    }
+    std::reverse(prices.begin() + static_cast<std::ptrdiff_t>(ask_count), prices.end());
+    std::inplace_merge(prices.begin(), prices.begin() + static_cast<std::ptrdiff_t>(ask_count), prices.end());
+    prices.erase(std::unique(prices.begin(), prices.end()), prices.end());
+    if (prices.empty()) return std::nullopt;
+
+    // cumulative curves: supply grows with price, demand shrinks
+    const std::size_t n = prices.size();
+    std::vector<uint64_t> supply(n), demand(n);
+    uint64_t cumulative = market_sell;
+    auto ask = asks_.begin();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (; ask != asks_.end() && ask->first <= prices[i]; ++ask) cumulative += auctionQuantity(ask->second);
+        supply[i] = cumulative;
+    }
+    cumulative = market_buy;
+    auto bid = bids_.begin();
+    for (std::size_t i = n; i-- > 0;) {
+        for (; bid != bids_.end() && bid->first >= prices[i]; ++bid) cumulative += auctionQuantity(bid->second);
+        demand[i] = cumulative;
+    }
+
+    // maximum volume, then minimum surplus
+    uint64_t best_volume = 0, best_surplus = 0;
+    std::vector<std::size_t> tied;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64_t volume = std::min(demand[i], supply[i]);
+        uint64_t surplus = std::max(demand[i], supply[i]) - volume;
+        if (volume > best_volume || (volume == best_volume && surplus < best_surplus)) {
+            best_volume = volume;
+            best_surplus = surplus;
+            tied.clear();
+        }
+        if (volume == best_volume && surplus == best_surplus) tied.push_back(i);
+    }
+    if (best_volume == 0) return std::nullopt;
+
+    // market pressure, then closeness to the reference price
+    bool buy_pressure = std::all_of(tied.begin(), tied.end(), [&](std::size_t i) { return demand[i] > supply[i]; });
+    bool sell_pressure = std::all_of(tied.begin(), tied.end(), [&](std::size_t i) { return supply[i] > demand[i]; });
+    std::size_t chosen = tied.front();
+    if (buy_pressure) {
+        chosen = tied.back();
+    } else if (!sell_pressure) {
+        double target = reference.value_or((prices[tied.front()] + prices[tied.back()]) / 2.0);
+        for (std::size_t i : tied) {
+            if (std::abs(prices[i] - target) < std::abs(prices[chosen] - target)) chosen = i;
+        }
+    }
+
+    return AuctionQuote{prices[chosen], best_volume,
+                        static_cast<int64_t>(demand[chosen]) - static_cast<int64_t>(supply[chosen])};
+}
+
+template <typename MatchingPolicy>
+std::vector<Trade> BasicOrderBook<MatchingPolicy>::uncross(uint64_t timestamp, std::optional<double> reference) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    phase_ = TradingPhase::CONTINUOUS;
+    std::vector<Trade> trades;
+
+    if (auto quote = equilibrium(reference)) {
+        const double price = quote->price;
+        uint64_t remaining = quote->volume;
+
+        // both sides in priority order: waiting market orders, then the best levels;
+        // the equilibrium volume never exceeds what either side offers at the price
+        while (remaining > 0) {
+            bool buy_market = !auction_buys_.empty();
+            bool sell_market = !auction_sells_.empty();
+            if ((!buy_market && bids_.empty()) || (!sell_market && asks_.empty())) break;
+
+            PriceLevel* bid_level = buy_market ? nullptr : &bids_.begin()->second;
+            PriceLevel* ask_level = sell_market ? nullptr : &asks_.begin()->second;
+            Order& buy = buy_market ? auction_buys_.front() : bid_level->orders.front();
+            Order& sell = sell_market ? auction_sells_.front() : ask_level->orders.front();
+
+            uint32_t qty = static_cast<uint32_t>(std::min<uint64_t>({buy.quantity, sell.quantity, remaining}));
+            auctionFill(buy, sell, qty, price, timestamp, trades);
+            remaining -= qty;
+
+            if (buy_market) {
+                if (buy.quantity == 0) auction_buys_.pop_front();
+            } else {
+                bid_level->quantity -= qty;
+                if (buy.quantity == 0) popFilled(*bid_level, timestamp);
+                if (bid_level->orders.empty()) bids_.erase(bids_.begin());
+            }
+            if (sell_market) {
+                if (sell.quantity == 0) auction_sells_.pop_front();
+            } else {
+                ask_level->quantity -= qty;
+                if (sell.quantity == 0) popFilled(*ask_level, timestamp);
+                if (ask_level->orders.empty()) asks_.erase(asks_.begin());
+            }
+        }
+    }
+
+    for (auto* queue : {&auction_buys_, &auction_sells_}) {
+        for (const auto& o : *queue) {
+            std::cout << "[OrderBook] Auction left market order ID " << o.id << " unfilled, dropped" << std::endl;
+        }
+        queue->clear();
+    }
+
+    if (trade_callback_) {
+        for (const auto& t : trades) {
+            trade_callback_(t);
+        }
+    }
+
+    publishTopOfBook();
+    return trades;
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::auctionFill(Order& buy, Order& sell, uint32_t qty, double price, uint64_t ts,
+                                                 std::vector<Trade>& trades) {
+    // no aggressor in an auction; report the side of the later order
+    Side side = sell.timestamp > buy.timestamp ? Side::SELL : Side::BUY;
+    trades.emplace_back(next_trade_id_++, buy.id, sell.id, instrument_, price, qty, ts, side);
+    trades.back().buy_owner_id = buy.owner_id;
+    trades.back().sell_owner_id = sell.owner_id;
+
+    std::cout << "[OrderBook] Auction trade executed: "
+              << "Trade ID " << trades.back().trade_id
+              << ", Buy ID " << buy.id
+              << ", Sell ID " << sell.id
+              << ", Price " << price
+              << ", Quantity " << qty << std::endl;
+
+    buy.quantity -= qty;
+    sell.quantity -= qty;
+    for (const Order* o : {&buy, &sell}) {
+        if (o->quantity > 0 && o->type == OrderType::LIMIT) {
+            orders_[o->id].quantity = o->quantity;
+        }
+    }
+}
+
+template <typename MatchingPolicy>
+BookState BasicOrderBook<MatchingPolicy>::saveState(std::vector<RestingOrder>& storage) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    storage.clear();
+    storage.reserve(orders_.size());
+    auto save = [&](const std::deque<Order>& queue) {
+        for (const auto& o : queue) {
+            RestingOrder r{};
+            r.id = o.id;
+            r.price = o.price;
+            r.timestamp = o.timestamp;
+            r.quantity = o.quantity;
+            r.display_quantity = o.display_quantity;
+            r.owner_id = o.owner_id;
+            r.side = static_cast<uint8_t>(o.side);
+            if (o.display_quantity != 0) {
+                auto it = iceberg_reserve_.find(o.id);
+                r.reserve = it == iceberg_reserve_.end() ? 0 : it->second;
+            }
+            storage.push_back(r);
+        }
+    };
+    for (const auto& [price, level] : bids_) save(level.orders);
+    for (const auto& [price, level] : asks_) save(level.orders);
+    std::size_t limit_count = storage.size();
+    save(auction_buys_);
+    save(auction_sells_);
+    for (std::size_t i = limit_count; i < storage.size(); ++i) storage[i].market = 1;
+
+    return BookState{next_trade_id_, last_top_.sequence, phase_, storage};
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::restoreState(const BookState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bids_.clear();
+    asks_.clear();
+    orders_.clear();
+    iceberg_reserve_.clear();
+    auction_buys_.clear();
+    auction_sells_.clear();
+    orders_.reserve(state.orders.size());
+    next_trade_id_ = state.next_trade_id;
+    phase_ = state.phase;
+
+    // saved orders come level by level from the best price, so every new
+    // level belongs at the end of its map and the hint makes insertion O(1)
+    auto restore = [&](auto& levels, const Order& order) {
+        PriceLevel& level = levels.try_emplace(levels.end(), order.price)->second;
+        level.orders.push_back(order);
+        level.quantity += order.quantity;
+    };
+    for (const RestingOrder& r : state.orders) {
+        Order order(r.id, instrument_, OrderType::LIMIT, static_cast<Side>(r.side), r.price, r.quantity, r.timestamp);
+        order.display_quantity = r.display_quantity;
+        order.owner_id = r.owner_id;
+        if (r.market) {
+            order.type = OrderType::MARKET;
+            (order.side == Side::BUY ? auction_buys_ : auction_sells_).push_back(std::move(order));
+            continue;
+        }
+        if (order.side == Side::BUY) {
+            restore(bids_, order);
+        } else {
+            restore(asks_, order);
+        }
+        if (r.reserve > 0) iceberg_reserve_[r.id] = r.reserve;
+        orders_.emplace(r.id, std::move(order));
+    }
+
+    TopOfBook top = currentTop();
+    top.sequence = state.top_sequence;
+    last_top_ = top;
+    top_of_book_.store(top);
+}
+
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::setTradeCallback(std::function<void(const Trade&)> cb) {
     trade_callback_ = cb;
 }
 
-}
\ No newline at end of file
+template <typename MatchingPolicy>
+void BasicOrderBook<MatchingPolicy>::setSelfTradePrevention(SelfTradePrevention mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stp_mode_ = mode;
+}
+
+template class BasicOrderBook<FifoMatching>;
+template class BasicOrderBook<ProRataMatching>;
+template class BasicOrderBook<ProRataTopOrderMatching>;
+
+}
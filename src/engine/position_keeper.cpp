@@ -0,0 +1,139 @@
+/**
+ * @file position_keeper.cpp
+ * @brief Implements average-cost position keeping and mark-to-market PnL.
+ */
+
+#include "engine/position_keeper.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace engine {
+
+using namespace core;
+
+namespace {
+
+// Mid of a two-sided book, or the fallback if either side is empty.
+double midOr(const OrderBook* book, double fallback) {
+    if (!book) return fallback;
+    TopOfBook top = book->topOfBook();
+    return top.hasBid() && top.hasAsk() ? (top.bid_price + top.ask_price) / 2.0 : fallback;
+}
+
+}
+
+void PositionKeeper::addInstrument(const std::string& instrument, const OrderBook* book) {
+    if (!accounts_.empty()) {
+        throw std::logic_error("PositionKeeper instruments must be added before accounts");
+    }
+    instruments_.try_emplace(instrument, Instrument{instruments_.size(), book});
+}
+
+void PositionKeeper::addAccount(uint32_t owner_id) {
+    auto account = std::make_unique<Account>();
+    account->positions = std::make_unique<Position[]>(instruments_.size());
+    account->published = std::make_unique<SeqLock<Position>[]>(instruments_.size());
+    if (!accounts_.try_emplace(owner_id, std::move(account)).second) {
+        throw std::invalid_argument("PositionKeeper account already exists: " + std::to_string(owner_id));
+    }
+}
+
+void PositionKeeper::onFill(const Trade& trade) {
+    auto it = instruments_.find(trade.instrument);
+    if (it == instruments_.end()) return;
+    const Instrument& instrument = it->second;
+
+    double mark = midOr(instrument.book, trade.price);
+    int64_t qty = trade.quantity;
+    if (Account* buyer = account(trade.buy_owner_id)) {
+        apply(*buyer, instrument.slot, qty, trade.price, mark);
+    }
+    if (Account* seller = account(trade.sell_owner_id)) {
+        apply(*seller, instrument.slot, -qty, trade.price, mark);
+    }
+}
+
+void PositionKeeper::mark(const std::string& instrument) {
+    auto it = instruments_.find(instrument);
+    if (it == instruments_.end() || !it->second.book) return;
+
+    double mid = midOr(it->second.book, 0.0);
+    if (mid == 0.0) return;
+    for (auto& [owner_id, acct] : accounts_) {
+        remark(*acct, it->second.slot, mid);
+    }
+}
+
+void PositionKeeper::apply(Account& acct, std::size_t slot, int64_t qty, double price, double mark) {
+    Position& pos = acct.positions[slot];
+    const double realized_before = pos.realized_pnl;
+    const double unrealized_before = pos.unrealized_pnl;
+
+    int64_t open = std::llabs(pos.quantity);
+    int64_t traded = std::llabs(qty);
+    if (pos.quantity == 0 || (pos.quantity > 0) == (qty > 0)) {
+        pos.average_cost = (pos.average_cost * open + price * traded) / static_cast<double>(open + traded);
+    } else {
+        // reducing: the closed part realizes against the average cost, any excess opens at price
+        int64_t closed = std::min(open, traded);
+        double direction = pos.quantity > 0 ? 1.0 : -1.0;
+        pos.realized_pnl += static_cast<double>(closed) * (price - pos.average_cost) * direction;
+        if (traded > open) {
+            pos.average_cost = price;
+        } else if (traded == open) {
+            pos.average_cost = 0.0;
+        }
+    }
+
+    pos.quantity += qty;
+    pos.fills++;
+    pos.filled_quantity += traded;
+    pos.mark_price = mark;
+    pos.unrealized_pnl = static_cast<double>(pos.quantity) * (mark - pos.average_cost);
+
+    acct.totals.fills++;
+    publish(acct, slot, pos.realized_pnl - realized_before, pos.unrealized_pnl - unrealized_before);
+}
+
+void PositionKeeper::remark(Account& acct, std::size_t slot, double mark) {
+    Position& pos = acct.positions[slot];
+    if (pos.mark_price == mark) return;
+
+    const double unrealized_before = pos.unrealized_pnl;
+    pos.mark_price = mark;
+    pos.unrealized_pnl = static_cast<double>(pos.quantity) * (mark - pos.average_cost);
+    publish(acct, slot, 0.0, pos.unrealized_pnl - unrealized_before);
+}
+
+void PositionKeeper::publish(Account& acct, std::size_t slot, double realized_delta, double unrealized_delta) {
+    acct.published[slot].store(acct.positions[slot]);
+
+    AccountPnL& totals = acct.totals;
+    totals.realized_pnl += realized_delta;
+    totals.unrealized_pnl += unrealized_delta;
+    totals.peak_pnl = std::max(totals.peak_pnl, totals.totalPnL());
+    totals.max_drawdown = std::max(totals.max_drawdown, totals.peak_pnl - totals.totalPnL());
+    acct.published_totals.store(totals);
+}
+
+Position PositionKeeper::position(uint32_t owner_id, const std::string& instrument) const {
+    Account* acct = account(owner_id);
+    auto it = instruments_.find(instrument);
+    if (!acct || it == instruments_.end()) return {};
+    return acct->published[it->second.slot].load();
+}
+
+AccountPnL PositionKeeper::pnl(uint32_t owner_id) const {
+    Account* acct = account(owner_id);
+    return acct ? acct->published_totals.load() : AccountPnL{};
+}
+
+PositionKeeper::Account* PositionKeeper::account(uint32_t owner_id) const {
+    if (owner_id == 0) return nullptr;
+    auto it = accounts_.find(owner_id);
+    return it != accounts_.end() ? it->second.get() : nullptr;
+}
+
+}
@@ -0,0 +1,166 @@
+/**
+ * @file queue_fill_model.cpp
+ * @brief Implements queue-position-aware fills for passive strategy orders.
+ */
+
+#include "engine/queue_fill_model.hpp"
+
+#include <algorithm>
+
+namespace engine {
+
+using namespace core;
+
+void QueueFillModel::add(const Order& order, uint64_t queue_ahead, uint64_t arrival) {
+    if (order.quantity == 0) return;
+
+    Book& book = books_[order.instrument];
+    ShadowLevel& level = (order.side == Side::BUY) ? book.bids_[order.price] : book.asks_[order.price];
+    level.push_back(ShadowOrder{order, queue_ahead, arrival});
+    index_[order.id] = Location{&book, order.side, order.price};
+}
+
+bool QueueFillModel::cancel(uint64_t order_id) {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) return false;
+
+    auto erase = [&](auto& levels) {
+        auto level_it = levels.find(it->second.price);
+        if (level_it == levels.end()) return;
+        auto& queue = level_it->second;
+        queue.erase(std::remove_if(queue.begin(), queue.end(),
+                        [&](const ShadowOrder& s) { return s.order.id == order_id; }),
+                    queue.end());
+        if (queue.empty()) levels.erase(level_it);
+    };
+
+    Book& book = *it->second.book;
+    if (it->second.side == Side::BUY) {
+        erase(book.bids_);
+    } else {
+        erase(book.asks_);
+    }
+    index_.erase(it);
+    return true;
+}
+
+void QueueFillModel::onTrade(const Trade& trade, std::vector<Trade>& fills) {
+    auto it = books_.find(trade.instrument);
+    if (it == books_.end()) return;
+
+    if (trade.side == Side::BUY) {
+        sweep<Side::BUY>(it->second, trade.instrument, trade.buy_order_id, trade.price,
+                         trade.quantity, true, trade.timestamp, fills);
+    } else {
+        sweep<Side::SELL>(it->second, trade.instrument, trade.sell_order_id, trade.price,
+                          trade.quantity, true, trade.timestamp, fills);
+    }
+}
+
+void QueueFillModel::onRest(const Order& order, std::vector<Trade>& fills) {
+    if (order.type != OrderType::LIMIT || order.quantity == 0) return;
+
+    auto it = books_.find(order.instrument);
+    if (it == books_.end()) return;
+
+    // the book had nothing at these prices, so no historical queue is ahead
+    if (order.side == Side::BUY) {
+        sweep<Side::BUY>(it->second, order.instrument, order.id, order.price,
+                         order.quantity, false, order.timestamp, fills);
+    } else {
+        sweep<Side::SELL>(it->second, order.instrument, order.id, order.price,
+                          order.quantity, false, order.timestamp, fills);
+    }
+}
+
+void QueueFillModel::onCancel(const Order& canceled) {
+    auto it = books_.find(canceled.instrument);
+    if (it == books_.end()) return;
+
+    ShadowLevel* level = (canceled.side == Side::BUY)
+        ? findLevel(it->second.bids_, canceled.price)
+        : findLevel(it->second.asks_, canceled.price);
+    if (!level) return;
+
+    for (auto& shadow : *level) {
+        // only orders that were already queued when the shadow arrived are ahead of it
+        if (canceled.timestamp <= shadow.arrival) {
+            shadow.ahead -= std::min<uint64_t>(shadow.ahead, canceled.quantity);
+        }
+    }
+}
+
+std::optional<uint64_t> QueueFillModel::queueAhead(uint64_t order_id) const {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) return std::nullopt;
+
+    const Location& loc = it->second;
+    const ShadowLevel* level = (loc.side == Side::BUY)
+        ? findLevel(loc.book->bids_, loc.price)
+        : findLevel(loc.book->asks_, loc.price);
+    if (!level) return std::nullopt;
+
+    for (const auto& shadow : *level) {
+        if (shadow.order.id == order_id) return shadow.ahead;
+    }
+    return std::nullopt;
+}
+
+/**
+ * Walks shadow levels from the best price while they cross the aggressive price.
+ */
+template <Side S>
+void QueueFillModel::sweep(Book& book, const std::string& instrument, uint64_t aggressor_id, double price,
+                           uint64_t volume, bool at_price_queued, uint64_t ts, std::vector<Trade>& fills) {
+    auto& levels = SideTraits<S>::opposite(book);
+
+    for (auto level_it = levels.begin();
+         level_it != levels.end() && volume > 0 && SideTraits<S>::crosses(price, level_it->first);) {
+        auto& queue = level_it->second;
+        const bool queued = at_price_queued && level_it->first == price;
+        uint64_t consumed = 0; // volume already given to earlier shadows at this level
+
+        for (auto& shadow : queue) {
+            uint64_t available = volume;
+            if (queued) {
+                if (available <= shadow.ahead) {
+                    shadow.ahead -= available;
+                    continue;
+                }
+                available -= shadow.ahead;
+                shadow.ahead = 0;
+            }
+            if (available <= consumed) continue;
+
+            uint32_t qty = static_cast<uint32_t>(
+                std::min<uint64_t>(available - consumed, shadow.order.quantity));
+            consumed += qty;
+            shadow.order.quantity -= qty;
+            fills.emplace_back(next_fill_id_++,
+                               S == Side::BUY ? aggressor_id : shadow.order.id,
+                               S == Side::BUY ? shadow.order.id : aggressor_id,
+                               instrument, level_it->first, qty, ts, S);
+            (S == Side::BUY ? fills.back().sell_owner_id : fills.back().buy_owner_id) = shadow.order.owner_id;
+        }
+
+        for (auto q_it = queue.begin(); q_it != queue.end();) {
+            if (q_it->order.quantity == 0) {
+                index_.erase(q_it->order.id);
+                q_it = queue.erase(q_it);
+            } else {
+                ++q_it;
+            }
+        }
+
+        // better-priced shadows would have traded before the printed level
+        if (!queued) volume -= std::min(volume, consumed);
+
+        if (queue.empty()) {
+            level_it = levels.erase(level_it);
+        } else {
+            ++level_it;
+        }
+    }
+}
+
+}
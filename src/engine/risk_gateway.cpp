@@ -0,0 +1,149 @@
+/**
+ * @file risk_gateway.cpp
+ * @brief Implements the pre-trade risk checks and fill-driven position tracking.
+ */
+
+#include "engine/risk_gateway.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace engine {
+
+using namespace core;
+
+const char* rejectReasonName(RejectReason reason) {
+    switch (reason) {
+        case RejectReason::NONE: return "none";
+        case RejectReason::KILL_SWITCH: return "kill switch";
+        case RejectReason::UNKNOWN_ACCOUNT: return "unknown account";
+        case RejectReason::UNKNOWN_INSTRUMENT: return "unknown instrument";
+        case RejectReason::ORDER_SIZE: return "order size";
+        case RejectReason::PRICE_COLLAR: return "price collar";
+        case RejectReason::POSITION_LIMIT: return "position limit";
+        case RejectReason::NOTIONAL_LIMIT: return "notional limit";
+        case RejectReason::RATE_LIMIT: return "rate limit";
+    }
+    return "unknown";
+}
+
+void RiskGateway::addInstrument(const std::string& instrument, const OrderBook* book) {
+    if (!accounts_.empty()) {
+        throw std::logic_error("RiskGateway instruments must be added before accounts");
+    }
+    instruments_.try_emplace(instrument, Instrument{instruments_.size(), book});
+}
+
+void RiskGateway::addAccount(uint32_t owner_id, const RiskLimits& limits) {
+    auto account = std::make_unique<Account>();
+    account->limits = limits;
+    account->positions = std::make_unique<std::atomic<int64_t>[]>(instruments_.size());
+    if (!accounts_.try_emplace(owner_id, std::move(account)).second) {
+        throw std::invalid_argument("RiskGateway account already exists: " + std::to_string(owner_id));
+    }
+}
+
+RejectReason RiskGateway::check(const Order& order, uint64_t now_us) {
+    Account* acct = account(order.owner_id);
+    if (!acct) return RejectReason::UNKNOWN_ACCOUNT;
+
+    RejectReason reason = evaluate(*acct, order, now_us);
+    if (reason != RejectReason::NONE) {
+        acct->rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    return reason;
+}
+
+RejectReason RiskGateway::evaluate(Account& acct, const Order& order, uint64_t now_us) const {
+    const RiskLimits& limits = acct.limits;
+
+    // every message counts toward the throttle, but a cancel is never refused
+    if (limits.max_orders_per_second > 0) {
+        uint64_t second = now_us / 1'000'000;
+        uint64_t window = acct.rate_window.load(std::memory_order_relaxed);
+        if (window != second && acct.rate_window.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+            acct.rate_count.store(0, std::memory_order_relaxed);
+        }
+        uint32_t sent = acct.rate_count.fetch_add(1, std::memory_order_relaxed);
+        if (order.quantity > 0 && sent >= limits.max_orders_per_second) return RejectReason::RATE_LIMIT;
+    }
+    if (order.quantity == 0) return RejectReason::NONE;
+
+    if (killed_.load(std::memory_order_acquire) || acct.killed.load(std::memory_order_acquire)) {
+        return RejectReason::KILL_SWITCH;
+    }
+
+    auto it = instruments_.find(order.instrument);
+    if (it == instruments_.end()) return RejectReason::UNKNOWN_INSTRUMENT;
+    const Instrument& instrument = it->second;
+
+    if (limits.max_order_quantity > 0 && order.quantity > limits.max_order_quantity) {
+        return RejectReason::ORDER_SIZE;
+    }
+
+    // market orders are valued at the touch they would take, else the other side
+    double price = order.price;
+    if ((limits.price_collar > 0.0 || limits.max_notional > 0.0) && instrument.book) {
+        TopOfBook top = instrument.book->topOfBook();
+        if (order.type == OrderType::MARKET) {
+            bool take_ask = order.side == Side::BUY ? top.hasAsk() : !top.hasBid();
+            price = take_ask ? (top.hasAsk() ? top.ask_price : 0.0) : top.bid_price;
+        } else if (limits.price_collar > 0.0 && top.hasBid() && top.hasAsk()) {
+            double mid = (top.bid_price + top.ask_price) / 2.0;
+            if (std::abs(order.price - mid) > limits.price_collar * mid) return RejectReason::PRICE_COLLAR;
+        }
+    }
+
+    int64_t signed_qty = order.side == Side::BUY ? order.quantity : -static_cast<int64_t>(order.quantity);
+    int64_t after = acct.positions[instrument.slot].load(std::memory_order_relaxed) + signed_qty;
+    if (limits.max_position > 0 && std::llabs(after) > limits.max_position) {
+        return RejectReason::POSITION_LIMIT;
+    }
+    if (limits.max_notional > 0.0) {
+        // a market order into an empty book has no price to value it at
+        if (order.type == OrderType::MARKET && price <= 0.0) return RejectReason::NOTIONAL_LIMIT;
+        if (static_cast<double>(std::llabs(after)) * price > limits.max_notional) return RejectReason::NOTIONAL_LIMIT;
+    }
+    return RejectReason::NONE;
+}
+
+void RiskGateway::onFill(const Trade& trade) {
+    auto it = instruments_.find(trade.instrument);
+    if (it == instruments_.end()) return;
+    std::size_t slot = it->second.slot;
+
+    if (Account* buyer = account(trade.buy_owner_id)) {
+        buyer->positions[slot].fetch_add(trade.quantity, std::memory_order_relaxed);
+    }
+    if (Account* seller = account(trade.sell_owner_id)) {
+        seller->positions[slot].fetch_sub(trade.quantity, std::memory_order_relaxed);
+    }
+}
+
+void RiskGateway::kill(uint32_t owner_id) {
+    if (Account* acct = account(owner_id)) acct->killed.store(true, std::memory_order_release);
+}
+
+void RiskGateway::resume(uint32_t owner_id) {
+    if (Account* acct = account(owner_id)) acct->killed.store(false, std::memory_order_release);
+}
+
+int64_t RiskGateway::position(uint32_t owner_id, const std::string& instrument) const {
+    Account* acct = account(owner_id);
+    auto it = instruments_.find(instrument);
+    if (!acct || it == instruments_.end()) return 0;
+    return acct->positions[it->second.slot].load(std::memory_order_relaxed);
+}
+
+uint64_t RiskGateway::rejectedCount(uint32_t owner_id) const {
+    Account* acct = account(owner_id);
+    return acct ? acct->rejected.load(std::memory_order_relaxed) : 0;
+}
+
+RiskGateway::Account* RiskGateway::account(uint32_t owner_id) const {
+    if (owner_id == 0) return nullptr;
+    auto it = accounts_.find(owner_id);
+    return it != accounts_.end() ? it->second.get() : nullptr;
+}
+
+}
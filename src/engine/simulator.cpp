@@ -4,38 +4,674 @@
  */
 
 #include "engine/simulator.hpp"
+#include "engine/checkpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
 namespace engine {
 
 using namespace core;
 using namespace strategy;
 
-void Simulator::registerStrategy(std::shared_ptr<Strategy> strategy) {
+Simulator::Simulator(std::shared_ptr<Clock> clock, std::shared_ptr<ThreadPool> executor) {
+    if (clock) {
+        clock_ = std::move(clock);
+        executor_ = std::move(executor);
+    } else {
+        // simulated runs stay on the caller's thread to remain deterministic
+        auto sim_clock = std::make_shared<SimulationClock>();
+        sim_clock_ = sim_clock.get();
+        clock_ = std::move(sim_clock);
+    }
+}
+
+void Simulator::registerStrategy(std::shared_ptr<Strategy> strategy, uint32_t owner_id) {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (executor_) {
+        auto strand = std::make_shared<Strand>(*executor_);
+        strategy->setClock(std::make_shared<StrandClock>(clock_, strand));
+        strands_.push_back(std::move(strand));
+    } else {
+        strategy->setClock(clock_);
+    }
+    std::size_t index = strategies_.size();
+    std::optional<std::size_t> book_index;
+    if (strategy->bookEventsEnabled()) {
+        std::lock_guard<std::mutex> events_lock(events_mutex_);
+        book_index = book_subscribers_.size();
+        book_subscribers_.push_back({index, strategy->coalesceBookEvents(), {}, false});
+    }
+
+    // indices only grow, so appending keeps every list in registration order
+    auto add = [&](Route& route, uint32_t events) {
+        if (events & MARKET_DATA) route.market_data.push_back(index);
+        if (events & TRADES) route.trades.push_back(index);
+        if (book_index && (events & BOOK_UPDATES)) route.book.push_back(*book_index);
+    };
+    if (strategy->subscriptions().empty()) {
+        add(any_route_, ALL_EVENTS);
+        for (auto& [instrument, route] : routes_) {
+            add(route, ALL_EVENTS);
+        }
+    } else {
+        for (const auto& [instrument, events] : strategy->subscriptions()) {
+            // a new instrument starts with the strategies that take everything
+            auto [it, inserted] = routes_.try_emplace(instrument, any_route_);
+            add(it->second, events);
+        }
+    }
+
+    if (owner_id != 0) {
+        owners_[owner_id] = index;
+    }
     strategies_.emplace_back(std::move(strategy));
 }
 
+const Simulator::Route& Simulator::routeFor(const std::string& instrument) const {
+    auto it = routes_.find(instrument);
+    return it != routes_.end() ? it->second : any_route_;
+}
+
 void Simulator::onOrder(const Order& order) {
+    if (auto event = applyOrder(order, JournalEvent::ORDER)) {
+        publishBookEvent(*event);
+    }
+    flushBookEvents();
+}
+
+std::optional<BookEvent> Simulator::applyOrder(const Order& order, JournalEvent source) {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto& book = books_.try_emplace(order.instrument, order.instrument).first->second;
+    record(source, order);
+    auto& book = bookFor(order.instrument);
+    const TopOfBook before = book.topOfBook();
     auto trades = book.addOrder(order);
 
+    processTrades(trades);
+
+    if (queue_fills_ && order.type == OrderType::LIMIT) {
+        uint32_t traded = 0;
+        for (const auto& trade : trades) {
+            traded += trade.quantity;
+        }
+        if (traded < order.quantity) {
+            // the remainder now rests and may cross passive strategy orders
+            Order rested = order;
+            rested.quantity = order.quantity - traded;
+            std::vector<Trade> fills;
+            queue_model_.onRest(rested, fills);
+            for (const auto& fill : fills) {
+                publishTrade(fill);
+            }
+        }
+    }
+
+    const TopOfBook after = book.topOfBook();
+    markPositions(order.instrument, before, after);
+    return bookChange(order.instrument, before, after, trades);
+}
+
+void Simulator::onMarketData(const Order& order) {
+    // fire strategy timers due before this tick; they may submit orders themselves
+    if (sim_clock_) {
+        sim_clock_->advanceTo(order.timestamp);
+        flushBookEvents();
+    }
+
+    auto event = applyOrder(order, JournalEvent::TICK);
+    publishMarketData(order);
+    if (event) {
+        publishBookEvent(*event);
+    }
+    flushBookEvents();
+}
+
+void Simulator::onCancel(const std::string& instrument, uint64_t order_id) {
+    std::optional<BookEvent> event;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record(JournalEvent::CANCEL, Order(order_id, instrument, OrderType::LIMIT, Side::BUY, 0.0, 0, clock_->now()));
+
+        auto& book = bookFor(instrument);
+        const TopOfBook before = book.topOfBook();
+
+        std::optional<Order> resting;
+        auto it = book.getOrders().find(order_id);
+        if (it != book.getOrders().end()) {
+            resting = it->second;
+        }
+
+        if (book.cancelOrder(order_id) && queue_fills_ && resting) {
+            queue_model_.onCancel(*resting);
+        }
+        const TopOfBook after = book.topOfBook();
+        markPositions(instrument, before, after);
+        event = bookChange(instrument, before, after, {});
+    }
+
+    if (event) {
+        publishBookEvent(*event);
+    }
+    flushBookEvents();
+}
+
+void Simulator::startAuction(const std::string& instrument) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    record(JournalEvent::AUCTION, Order(0, instrument, OrderType::LIMIT, Side::BUY, 0.0, 0, clock_->now()));
+    bookFor(instrument).startAuction();
+}
+
+void Simulator::uncross(const std::string& instrument, std::optional<double> reference) {
+    std::optional<BookEvent> event;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record(JournalEvent::UNCROSS, Order(0, instrument, OrderType::LIMIT, Side::BUY,
+                                            reference.value_or(std::numeric_limits<double>::quiet_NaN()), 0, clock_->now()));
+
+        auto& book = bookFor(instrument);
+        const TopOfBook before = book.topOfBook();
+        auto trades = book.uncross(clock_->now(), reference);
+        processTrades(trades);
+        const TopOfBook after = book.topOfBook();
+        markPositions(instrument, before, after);
+        event = bookChange(instrument, before, after, trades);
+    }
+
+    if (event) {
+        publishBookEvent(*event);
+    }
+    flushBookEvents();
+}
+
+OrderBook& Simulator::getBook(const std::string& instrument) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bookFor(instrument);
+}
+
+OrderBook& Simulator::bookFor(const std::string& instrument) {
+    return books_.try_emplace(instrument, instrument, stp_mode_).first->second;
+}
+
+SubmitOrderCallback Simulator::makeSubmitter(uint32_t owner_id) {
+    return [this, owner_id](const Order& order) {
+        Order owned = order;
+        owned.owner_id = owner_id;
+
+        std::shared_ptr<RiskGateway> risk;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            risk = risk_;
+        }
+        if (risk) {
+            RejectReason reason = risk->check(owned, clock_->now());
+            if (reason != RejectReason::NONE) {
+                rejectOrder(owned, reason);
+                return;
+            }
+        }
+
+        uint64_t delay = 0;
+        if (sim_clock_ && order_latency_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            delay = arrivalDelay(*order_latency_, owned.instrument, last_order_arrival_[owner_id]);
+        }
+
+        if (delay == 0) {
+            routeStrategyOrder(owned);
+        } else {
+            clock_->schedule(delay, 0, [this, owned] { routeStrategyOrder(owned); });
+        }
+    };
+}
+
+// Strategy orders only queue their book events: delivering them here would
+// call back into a strategy that may still be inside its own callback.
+void Simulator::routeStrategyOrder(const Order& order) {
+    // strategies cancel by resubmitting an order ID with zero quantity
+    if (order.quantity == 0) {
+        cancelStrategyOrder(order);
+        return;
+    }
+
+    if (!queue_fills_) {
+        if (auto event = applyOrder(order, JournalEvent::STRATEGY_ORDER)) {
+            publishBookEvent(*event);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    record(JournalEvent::STRATEGY_ORDER, order);
+
+    auto& book = bookFor(order.instrument);
+    Order passive = order;
+    std::optional<BookEvent> event;
+
+    const TopOfBook top = book.topOfBook();
+    bool crosses = order.type == OrderType::MARKET ||
+        (order.side == Side::BUY ? top.hasAsk() && order.price >= top.ask_price
+                                 : top.hasBid() && order.price <= top.bid_price);
+    if (crosses) {
+        // take the historical liquidity now; only the remainder waits in the queue model
+        auto trades = book.addOrder(order);
+        for (const auto& trade : trades) {
+            passive.quantity -= trade.quantity;
+        }
+        if (order.type == OrderType::LIMIT && passive.quantity > 0) {
+            // as in cancelStrategyOrder, never pull a historical order that shares the ID
+            auto it = book.getOrders().find(order.id);
+            if (it != book.getOrders().end() && it->second.owner_id == order.owner_id) {
+                book.cancelOrder(order.id);
+            }
+        }
+        processTrades(trades);
+        const TopOfBook after = book.topOfBook();
+        markPositions(order.instrument, top, after);
+        event = bookChange(order.instrument, top, after, trades);
+    }
+
+    if (order.type == OrderType::LIMIT && passive.quantity > 0) {
+        queue_model_.add(passive, book.levelQuantity(order.side, order.price), clock_->now());
+    }
+
+    lock.unlock();
+    if (event) {
+        publishBookEvent(*event);
+    }
+}
+
+// Only the submitting owner's own order is removed, so a strategy ID that
+// collides with a historical order ID never cancels market data.
+void Simulator::cancelStrategyOrder(const Order& order) {
+    std::optional<BookEvent> event;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record(JournalEvent::STRATEGY_CANCEL, order);
+
+        if (queue_fills_) {
+            queue_model_.cancel(order.id);
+        }
+
+        auto& book = bookFor(order.instrument);
+        auto it = book.getOrders().find(order.id);
+        if (it == book.getOrders().end() || it->second.owner_id != order.owner_id) return;
+
+        const TopOfBook before = book.topOfBook();
+        book.cancelOrder(order.id);
+        const TopOfBook after = book.topOfBook();
+        markPositions(order.instrument, before, after);
+        event = bookChange(order.instrument, before, after, {});
+    }
+
+    if (event) {
+        publishBookEvent(*event);
+    }
+}
+
+void Simulator::setJournal(std::shared_ptr<JournalWriter> journal) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    journal_ = std::move(journal);
+}
+
+void Simulator::record(JournalEvent event, const Order& order) {
+    if (journal_) {
+        journal_position_.store(journal_->append(event, clock_->now(), order) + 1, std::memory_order_release);
+    }
+}
+
+void Simulator::replay(const JournalRecord& record) {
+    // strategy orders and cancels carry no time of their own
+    if (sim_clock_) {
+        sim_clock_->advanceTo(record.sim_time);
+    }
+
+    switch (record.event) {
+    case JournalEvent::TICK:
+        onMarketData(record.order);
+        break;
+    case JournalEvent::ORDER:
+        onOrder(record.order);
+        break;
+    case JournalEvent::STRATEGY_ORDER:
+        routeStrategyOrder(record.order);
+        flushBookEvents();
+        break;
+    case JournalEvent::STRATEGY_CANCEL:
+        cancelStrategyOrder(record.order);
+        flushBookEvents();
+        break;
+    case JournalEvent::CANCEL:
+        onCancel(record.order.instrument, record.order.id);
+        break;
+    case JournalEvent::AUCTION:
+        startAuction(record.order.instrument);
+        break;
+    case JournalEvent::UNCROSS:
+        uncross(record.order.instrument, std::isnan(record.order.price)
+                                             ? std::nullopt : std::optional<double>(record.order.price));
+        break;
+    }
+    journal_position_.store(record.sequence + 1, std::memory_order_release);
+}
+
+void Simulator::saveCheckpoint(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckpointWriter writer(journal_position_.load(std::memory_order_acquire), clock_->now());
+
+    // sorted so the same state always produces the same file
+    std::vector<const std::string*> instruments;
+    for (const auto& [instrument, book] : books_) instruments.push_back(&instrument);
+    std::sort(instruments.begin(), instruments.end(), [](auto* a, auto* b) { return *a < *b; });
+
+    std::vector<RestingOrder> storage;
+    for (const std::string* instrument : instruments) {
+        writer.addBook(*instrument, books_.at(*instrument).saveState(storage));
+    }
+    for (const auto& strategy : strategies_) {
+        std::string state;
+        strategy->saveState(state);
+        writer.addStrategy(strategy->name(), state);
+    }
+    writer.write(path);
+}
+
+uint64_t Simulator::restoreCheckpoint(const std::string& path) {
+    MappedCheckpoint checkpoint(path);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto& saved = checkpoint.strategies();
+        bool same = saved.size() == strategies_.size();
+        for (std::size_t i = 0; same && i < saved.size(); ++i) {
+            same = saved[i].name == strategies_[i]->name();
+        }
+        if (!same) {
+            throw std::runtime_error("Checkpoint strategies do not match the registered ones: " + path);
+        }
+
+        for (const auto& book : checkpoint.books()) {
+            bookFor(std::string(book.instrument)).restoreState(book.state);
+        }
+        for (std::size_t i = 0; i < saved.size(); ++i) {
+            strategies_[i]->restoreState(saved[i].state);
+        }
+        journal_position_.store(checkpoint.journalSequence(), std::memory_order_release);
+    }
+
+    // no timers are armed before start(), so this only moves the clock
+    if (sim_clock_) {
+        sim_clock_->advanceTo(checkpoint.simTime());
+    }
+    return checkpoint.journalSequence();
+}
+
+void Simulator::setQueuePositionFills(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_fills_ = enabled;
+}
+
+void Simulator::setOrderEntryLatency(std::unique_ptr<LatencyModel> model) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    order_latency_ = std::move(model);
+}
+
+void Simulator::setMarketDataLatency(std::unique_ptr<LatencyModel> model) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    md_latency_ = std::move(model);
+}
+
+uint64_t Simulator::arrivalDelay(LatencyModel& model, const std::string& instrument, uint64_t& last_arrival) {
+    uint64_t now = clock_->now();
+    // a later message on the same channel never overtakes an earlier one
+    uint64_t arrival = std::max(now + model.sample(instrument), last_arrival);
+    last_arrival = arrival;
+    return arrival - now;
+}
+
+void Simulator::processTrades(const std::vector<Trade>& trades) {
+    std::vector<Trade> fills;
     for (const auto& trade : trades) {
-        for (const auto& strategy : strategies_) {
-            strategy->onTrade(trade);
+        publishTrade(trade);
+        if (queue_fills_) {
+            queue_model_.onTrade(trade, fills);
         }
     }
+    for (const auto& fill : fills) {
+        publishTrade(fill);
+    }
+}
+
+// Called with mutex_ held.
+void Simulator::publishTrade(const Trade& trade) {
+    if (risk_) {
+        risk_->onFill(trade);
+    }
+    if (positions_) {
+        positions_->onFill(trade);
+    }
+
+    uint64_t delay = 0;
+    if (sim_clock_ && md_latency_) {
+        delay = arrivalDelay(*md_latency_, trade.instrument, last_md_arrival_);
+    }
+
+    if (delay == 0) {
+        deliverTrade(trade);
+        return;
+    }
+
+    clock_->schedule(delay, 0, [this, trade] {
+        std::lock_guard<std::mutex> lock(mutex_);
+        deliverTrade(trade);
+    });
+}
+
+void Simulator::publishMarketData(const Order& order) {
+    uint64_t delay = 0;
+    if (sim_clock_ && md_latency_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        delay = arrivalDelay(*md_latency_, order.instrument, last_md_arrival_);
+    }
+
+    if (delay == 0) {
+        deliverMarketData(order);
+        return;
+    }
+
+    clock_->schedule(delay, 0, [this, order] { deliverMarketData(order); });
+}
+
+std::optional<BookEvent> Simulator::bookChange(const std::string& instrument, const TopOfBook& before,
+                                               const TopOfBook& after, const std::vector<Trade>& trades) const {
+    bool bbo_changed = after.sequence != before.sequence;
+    if (routeFor(instrument).book.empty() || (!bbo_changed && trades.empty())) {
+        return std::nullopt;
+    }
+
+    BookEvent event;
+    event.instrument = instrument;
+    event.top = after;
+    event.bbo_changed = bbo_changed;
+    for (const auto& trade : trades) {
+        event.traded_quantity += trade.quantity;
+        event.last_trade_price = trade.price;
+    }
+    event.timestamp = clock_->now();
+    return event;
+}
+
+void Simulator::markPositions(const std::string& instrument, const TopOfBook& before, const TopOfBook& after) {
+    if (positions_ && after.sequence != before.sequence) {
+        positions_->mark(instrument);
+    }
+}
+
+void Simulator::publishBookEvent(const BookEvent& event) {
+    uint64_t delay = 0;
+    if (sim_clock_ && md_latency_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        delay = arrivalDelay(*md_latency_, event.instrument, last_md_arrival_);
+    }
+
+    if (delay == 0) {
+        deliverBookEvent(event);
+        return;
+    }
+
+    clock_->schedule(delay, 0, [this, event] { deliverBookEvent(event); });
+}
+
+void Simulator::deliverBookEvent(const BookEvent& event) {
+    std::vector<std::size_t> to_post;
+    {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        for (std::size_t i : routeFor(event.instrument).book) {
+            auto& sub = book_subscribers_[i];
+            auto waiting = std::find_if(sub.pending.begin(), sub.pending.end(),
+                [&](const BookEvent& e) { return e.instrument == event.instrument; });
+            if (sub.coalesce && waiting != sub.pending.end()) {
+                waiting->merge(event);
+            } else {
+                sub.pending.push_back(event);
+            }
+
+            if (executor_ && !sub.draining) {
+                sub.draining = true;
+                to_post.push_back(i);
+            }
+        }
+    }
+
+    for (std::size_t i : to_post) {
+        strands_[book_subscribers_[i].index]->post([this, i] { drainBookEvents(i); });
+    }
+}
+
+bool Simulator::drainBookEvents(std::size_t subscriber) {
+    const auto& strategy = strategies_[book_subscribers_[subscriber].index];
+    bool delivered = false;
+
+    std::unique_lock<std::mutex> lock(events_mutex_);
+    auto& sub = book_subscribers_[subscriber];
+    // on a strand the flag was taken when the drain was posted
+    if (!executor_) {
+        if (sub.draining) return false;
+        sub.draining = true;
+    }
+
+    while (!sub.pending.empty()) {
+        BookEvent event = std::move(sub.pending.front());
+        sub.pending.pop_front();
+        lock.unlock();
+        strategy->onBookUpdate(event);
+        delivered = true;
+        lock.lock();
+    }
+    sub.draining = false;
+    return delivered;
+}
+
+void Simulator::flushBookEvents() {
+    if (executor_) return;
+
+    // a strategy's reaction may queue events for the ones already drained
+    bool delivered = true;
+    while (delivered) {
+        delivered = drainRejections();
+        for (std::size_t i = 0; i < book_subscribers_.size(); ++i) {
+            delivered = drainBookEvents(i) || delivered;
+        }
+    }
+}
+
+void Simulator::setRiskGateway(std::shared_ptr<RiskGateway> gateway) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    risk_ = std::move(gateway);
+}
+
+void Simulator::setPositionKeeper(std::shared_ptr<PositionKeeper> keeper) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    positions_ = std::move(keeper);
+}
+
+// Like book events, a reject never reaches the strategy inside the callback
+// that submitted the order.
+void Simulator::rejectOrder(const Order& order, RejectReason reason) {
+    auto it = owners_.find(order.owner_id);
+    if (it == owners_.end()) return;
+    std::size_t index = it->second;
+
+    if (executor_) {
+        strands_[index]->post([strategy = strategies_[index], order, reason] {
+            strategy->onOrderRejected(order, reason);
+        });
+        return;
+    }
+    std::lock_guard<std::mutex> lock(events_mutex_);
+    pending_rejects_.push_back({index, order, reason});
+}
+
+bool Simulator::drainRejections() {
+    bool delivered = false;
+    std::unique_lock<std::mutex> lock(events_mutex_);
+    while (!pending_rejects_.empty()) {
+        Rejection reject = std::move(pending_rejects_.front());
+        pending_rejects_.pop_front();
+        lock.unlock();
+        strategies_[reject.index]->onOrderRejected(reject.order, reject.reason);
+        delivered = true;
+        lock.lock();
+    }
+    return delivered;
+}
+
+void Simulator::deliverTrade(const Trade& trade) {
+    for (std::size_t i : routeFor(trade.instrument).trades) {
+        if (executor_) {
+            strands_[i]->post([strategy = strategies_[i], trade] { strategy->onTrade(trade); });
+        } else {
+            strategies_[i]->onTrade(trade);
+        }
+    }
+}
+
+void Simulator::deliverMarketData(const Order& order) {
+    for (std::size_t i : routeFor(order.instrument).market_data) {
+        if (executor_) {
+            strands_[i]->post([strategy = strategies_[i], order] { strategy->onMarketData(order); });
+        } else {
+            strategies_[i]->onMarketData(order);
+        }
+    }
+}
+
+void Simulator::setSelfTradePrevention(SelfTradePrevention mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stp_mode_ = mode;
+    for (auto& [instrument, book] : books_) {
+        book.setSelfTradePrevention(mode);
+    }
 }
 
 void Simulator::start() {
-    for (auto& strategy : strategies_) {
-        strategy->start();
+    for (std::size_t i = 0; i < strategies_.size(); ++i) {
+        if (executor_) {
+            strands_[i]->invoke([strategy = strategies_[i]] { strategy->start(); });
+        } else {
+            strategies_[i]->start();
+        }
     }
 }
 
 void Simulator::stop() {
-    for (auto& strategy : strategies_) {
-        strategy->stop();
+    for (std::size_t i = 0; i < strategies_.size(); ++i) {
+        if (executor_) {
+            // runs after every callback already queued for the strategy
+            strands_[i]->invoke([strategy = strategies_[i]] { strategy->stop(); });
+        } else {
+            strategies_[i]->stop();
+        }
     }
 }
 
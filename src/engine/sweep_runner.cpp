@@ -0,0 +1,118 @@
+/**
+ * @file sweep_runner.cpp
+ * @brief Implements the parallel parameter-sweep backtest runner.
+ */
+
+#include "engine/sweep_runner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace engine {
+
+using namespace core;
+
+SweepRunner::SweepRunner(std::shared_ptr<const std::vector<Order>> ticks,
+                         StrategyFactory factory,
+                         unsigned threads)
+    : ticks_(std::move(ticks)),
+      factory_(std::move(factory)),
+      threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+std::vector<SweepResult> SweepRunner::run(const std::vector<SweepParams>& grid) const {
+    std::vector<SweepResult> results(grid.size());
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&] {
+        for (std::size_t i = next++; i < grid.size(); i = next++) {
+            try {
+                results[i] = runOne(grid[i]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::size_t count = std::min<std::size_t>(threads_, grid.size());
+    std::vector<std::thread> workers;
+    workers.reserve(count);
+    for (std::size_t t = 0; t < count; ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    if (error) std::rethrow_exception(error);
+    return results;
+}
+
+SweepResult SweepRunner::runOne(const SweepParams& params) const {
+    Simulator simulator;
+    auto strat = factory_(simulator, params);
+    if (!strat) {
+        throw std::invalid_argument("Sweep strategy factory returned no strategy");
+    }
+
+    simulator.registerStrategy(strat, owner_id);
+    simulator.start();
+    for (const auto& tick : *ticks_) {
+        simulator.onMarketData(tick);
+    }
+    simulator.stop();
+
+    SweepResult result;
+    result.params = params;
+    result.total_trades = strat->totalTrades();
+    result.average_trade_size = strat->averageTradeSize();
+    result.realized_pnl = strat->realizedPnL();
+    result.max_drawdown = strat->maxDrawdown();
+    result.risk_breached = strat->riskViolated();
+    return result;
+}
+
+std::vector<SweepParams> SweepRunner::grid(const std::vector<double>& spreads,
+                                           const std::vector<int>& sizes,
+                                           const std::vector<double>& risks) {
+    std::vector<SweepParams> out;
+    out.reserve(spreads.size() * sizes.size() * risks.size());
+    for (double spread : spreads) {
+        for (int size : sizes) {
+            for (double risk : risks) {
+                out.push_back({spread, size, risk});
+            }
+        }
+    }
+    return out;
+}
+
+void SweepRunner::writeCsv(const std::vector<SweepResult>& results, const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open sweep results file: " + path);
+    }
+
+    out << "run,spread,size,risk,total_trades,average_trade_size,realized_pnl,max_drawdown,risk_breached\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << i << ","
+            << r.params.spread << ","
+            << r.params.size << ","
+            << r.params.risk << ","
+            << r.total_trades << ","
+            << r.average_trade_size << ","
+            << r.realized_pnl << ","
+            << r.max_drawdown << ","
+            << (r.risk_breached ? "true" : "false") << "\n";
+    }
+}
+
+}
@@ -0,0 +1,197 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implements the work-stealing thread pool, strands and strand-bound clock.
+ */
+
+#include "engine/thread_pool.hpp"
+
+#include <algorithm>
+#include <future>
+#include <iostream>
+
+namespace engine {
+
+namespace {
+
+// Pool and worker index of the calling thread, if it is a pool worker.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local unsigned current_worker = 0;
+
+}
+
+// ThreadPool
+
+ThreadPool::ThreadPool(unsigned threads) {
+    unsigned count = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < count; ++i) {
+        threads_.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stopping_ = true;
+    }
+    idle_cv_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    unsigned index = (current_pool == this)
+        ? current_worker
+        : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+    // count the task before a worker can take it, so pending_ never drops below zero
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        ++pending_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    idle_cv_.notify_one();
+}
+
+bool ThreadPool::take(unsigned index, Task& task) {
+    // own deque first, newest task (still warm in cache)
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // steal the oldest task from the others
+    for (std::size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(unsigned index) {
+    current_pool = this;
+    current_worker = index;
+
+    Task task;
+    while (true) {
+        if (take(index, task)) {
+            --pending_;
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_cv_.wait(lock, [this] { return pending_ > 0 || stopping_; });
+        if (stopping_ && pending_ == 0) return;
+    }
+}
+
+// Strand
+
+void Strand::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+        if (scheduled_) return;
+        scheduled_ = true;
+    }
+    pool_.submit([self = shared_from_this()] { self->drain(); });
+}
+
+void Strand::invoke(Task task) {
+    std::promise<void> done;
+    auto finished = done.get_future();
+    post([&] {
+        try {
+            task();
+            done.set_value();
+        } catch (...) {
+            done.set_exception(std::current_exception());
+        }
+    });
+    finished.get();
+}
+
+void Strand::drain() {
+    for (std::size_t i = 0; i < batch_size_; ++i) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty()) {
+                scheduled_ = false;
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& ex) {
+            std::cerr << "[Strand] Task failed: " << ex.what() << "\n";
+        }
+    }
+
+    // give the worker back to other strands, continue later
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            scheduled_ = false;
+            return;
+        }
+    }
+    pool_.submit([self = shared_from_this()] { self->drain(); });
+}
+
+// StrandClock
+
+TimerId StrandClock::schedule(uint64_t delay_us, uint64_t interval_us, TimerCallback cb) {
+    auto state = std::make_shared<TimerState>();
+
+    TimerId id = clock_->schedule(delay_us, interval_us,
+        [strand = strand_, state, cb = std::move(cb)] {
+            if (!state->active || state->queued.exchange(true)) return;
+            strand->post([state, cb] {
+                state->queued = false;
+                if (state->active) cb();
+            });
+        });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    timers_[id] = std::move(state);
+    return id;
+}
+
+void StrandClock::cancel(TimerId id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = timers_.find(id);
+        if (it != timers_.end()) {
+            it->second->active = false;
+            timers_.erase(it);
+        }
+    }
+    clock_->cancel(id);
+}
+
+}
@@ -0,0 +1,25 @@
+/**
+ * @file tick_columns.cpp
+ * @brief Implements loading of journaled ticks into per-instrument columns.
+ */
+
+#include "engine/tick_columns.hpp"
+#include "engine/journal.hpp"
+
+namespace engine {
+
+std::map<std::string, TickColumns> loadTickColumns(const std::string& journal_path) {
+    std::map<std::string, TickColumns> columns;
+    JournalReader reader(journal_path);
+    JournalRecord record;
+    while (reader.next(record)) {
+        if (record.event != JournalEvent::TICK) continue;
+        auto& column = columns[record.order.instrument];
+        column.timestamps.push_back(record.order.timestamp);
+        column.prices.push_back(record.order.price);
+        column.quantities.push_back(record.order.quantity);
+    }
+    return columns;
+}
+
+}
@@ -0,0 +1,153 @@
+/**
+ * @file arbitrage_graph.cpp
+ * @brief Implements cycle enumeration and incremental cycle re-evaluation for ArbitrageGraph.
+ */
+
+#include "strategy/arbitrage_graph.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace strategy {
+
+using namespace core;
+
+namespace {
+constexpr double unavailable = std::numeric_limits<double>::infinity();
+}
+
+ArbitrageGraph::ArbitrageGraph(std::size_t max_cycle_length, double fee_rate, double min_profit)
+    : max_cycle_length_(max_cycle_length),
+      fee_weight_(-std::log1p(-fee_rate)),
+      profit_threshold_(-std::log1p(min_profit)) {
+    if (max_cycle_length < 2 || max_cycle_length > 6) {
+        throw std::invalid_argument("Arbitrage cycle length must be between 2 and 6");
+    }
+    if (!(fee_rate >= 0.0 && fee_rate < 1.0)) {
+        throw std::invalid_argument("Arbitrage fee rate must be in [0, 1)");
+    }
+}
+
+std::size_t ArbitrageGraph::addPair(const std::string& instrument) {
+    auto dash = instrument.find('-');
+    if (dash == std::string::npos || dash == 0 || dash + 1 == instrument.size()) {
+        throw std::invalid_argument("Pair name must look like BASE-QUOTE: " + instrument);
+    }
+    return addPair(instrument, instrument.substr(0, dash), instrument.substr(dash + 1));
+}
+
+std::size_t ArbitrageGraph::addPair(const std::string& instrument, const std::string& base, const std::string& quote) {
+    if (base == quote) {
+        throw std::invalid_argument("Pair base and quote must differ: " + instrument);
+    }
+    if (pair_index_.count(instrument)) {
+        throw std::invalid_argument("Pair already added: " + instrument);
+    }
+    std::size_t index = pairs_.size();
+    pairs_.push_back({instrument, currencyIndex(base), currencyIndex(quote)});
+    pair_index_.emplace(instrument, index);
+    edge_weight_.push_back(unavailable);
+    edge_weight_.push_back(unavailable);
+
+    // setup-time cost: every cycle is found again, including the new pair's
+    enumerateCycles();
+    return index;
+}
+
+void ArbitrageGraph::update(std::size_t pair, double bid, double ask, std::vector<ArbitrageOpportunity>& out) {
+    Pair& p = pairs_[pair];
+    p.bid = bid;
+    p.ask = ask;
+    edge_weight_[2 * pair] = ask > 0.0 ? std::log(ask) + fee_weight_ : unavailable;
+    edge_weight_[2 * pair + 1] = bid > 0.0 ? -std::log(bid) + fee_weight_ : unavailable;
+
+    // a cycle never trades the same pair twice, so each one is checked once
+    for (uint32_t cycle : pair_cycles_[pair]) {
+        double weight = cycleWeight(cycle);
+        if (weight < profit_threshold_) {
+            out.push_back({cycle, std::expm1(-weight)});
+        }
+    }
+}
+
+void ArbitrageGraph::profitableCycles(std::vector<ArbitrageOpportunity>& out) const {
+    for (std::size_t cycle = 0; cycle < cycleCount(); ++cycle) {
+        double weight = cycleWeight(cycle);
+        if (weight < profit_threshold_) {
+            out.push_back({cycle, std::expm1(-weight)});
+        }
+    }
+}
+
+std::span<const CycleLeg> ArbitrageGraph::legs(std::size_t cycle) const {
+    return std::span<const CycleLeg>(cycle_legs_).subspan(cycle_offsets_[cycle], cycle_offsets_[cycle + 1] - cycle_offsets_[cycle]);
+}
+
+std::size_t ArbitrageGraph::currencyIndex(const std::string& currency) {
+    return currencies_.try_emplace(currency, currencies_.size()).first->second;
+}
+
+double ArbitrageGraph::cycleWeight(std::size_t cycle) const {
+    double weight = 0.0;
+    for (std::size_t i = cycle_offsets_[cycle]; i < cycle_offsets_[cycle + 1]; ++i) {
+        const CycleLeg& leg = cycle_legs_[i];
+        weight += edge_weight_[2 * leg.pair + (leg.side == Side::SELL ? 1 : 0)];
+    }
+    return weight;
+}
+
+void ArbitrageGraph::enumerateCycles() {
+    cycle_legs_.clear();
+    cycle_offsets_.assign(1, 0);
+    pair_cycles_.assign(pairs_.size(), {});
+
+    struct Edge {
+        std::size_t to;
+        CycleLeg leg;
+    };
+    std::vector<std::vector<Edge>> outgoing(currencies_.size());
+    for (std::size_t p = 0; p < pairs_.size(); ++p) {
+        outgoing[pairs_[p].quote].push_back({pairs_[p].base, {p, Side::BUY}});
+        outgoing[pairs_[p].base].push_back({pairs_[p].quote, {p, Side::SELL}});
+    }
+
+    // each directed cycle is found once, from its lowest-numbered currency
+    std::vector<CycleLeg> path;
+    std::vector<bool> on_path(currencies_.size(), false);
+    std::vector<bool> pair_used(pairs_.size(), false);
+
+    auto record = [&] {
+        auto cycle = static_cast<uint32_t>(cycle_offsets_.size() - 1);
+        for (const CycleLeg& leg : path) {
+            cycle_legs_.push_back(leg);
+            pair_cycles_[leg.pair].push_back(cycle);
+        }
+        cycle_offsets_.push_back(cycle_legs_.size());
+    };
+
+    auto extend = [&](auto& self, std::size_t start, std::size_t node) -> void {
+        for (const Edge& edge : outgoing[node]) {
+            if (pair_used[edge.leg.pair]) continue;
+            path.push_back(edge.leg);
+            pair_used[edge.leg.pair] = true;
+            if (edge.to == start) {
+                if (path.size() >= 2) record();
+            } else if (edge.to > start && !on_path[edge.to] && path.size() < max_cycle_length_) {
+                on_path[edge.to] = true;
+                self(self, start, edge.to);
+                on_path[edge.to] = false;
+            }
+            pair_used[edge.leg.pair] = false;
+            path.pop_back();
+        }
+    };
+
+    for (std::size_t start = 0; start < currencies_.size(); ++start) {
+        on_path[start] = true;
+        extend(extend, start, start);
+        on_path[start] = false;
+    }
+}
+
+}
@@ -24,12 +24,19 @@ ArbitrageTrader::ArbitrageTrader(const std::string& asset1,
       spread_(spread),
       order_size_(order_size),
       running_(false),
-      max_loss_(max_loss) {}
+      max_loss_(max_loss) {
+    // quotes come from the books' BBO, not from individual ticks
+    subscribe(symbol1_, TRADES | BOOK_UPDATES);
+    subscribe(symbol2_, TRADES | BOOK_UPDATES);
+    subscribeBookEvents();
+}
 
 void ArbitrageTrader::start() {
     running_ = true;
     std::cout << "[ArbitrageTrader] Started arbitrage between " << symbol1_ << " and " << symbol2_ << std::endl;
-    trade_log_.open("logs/arbitrage_trades.csv");
+    if (auto path = logPath("arbitrage_trades.csv"); !path.empty()) {
+        trade_log_.open(path);
+    }
     trade_log_ << "trade_id,instrument,price,quantity,pnl,position_" << symbol1_
                << ",position_" << symbol2_ << ",total_pnl,risk_breached,timestamp\n";
 }
@@ -42,19 +49,26 @@ void ArbitrageTrader::stop() {
     }
 }
 
-void ArbitrageTrader::onMarketData(const Order& order) {
-    if (!running_) return;
+void ArbitrageTrader::onMarketData(const Order&) {
+    // a tick says nothing about what is still resting; onBookUpdate has the BBO
+}
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (order.side == Side::BUY) {
-        best_bid_[order.instrument] = std::max(best_bid_[order.instrument], order.price);
-    } else {
-        if (best_ask_.count(order.instrument) == 0 || order.price < best_ask_[order.instrument]) {
-            best_ask_[order.instrument] = order.price;
-        }
+void ArbitrageTrader::onBookUpdate(const engine::BookEvent& event) {
+    if (!running_ || !event.bbo_changed) return;
+    int leg = legIndex(event.instrument);
+    if (leg < 0) return;
+
+    std::vector<Order> orders;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        top_[leg] = event.top;
+        checkArbitrageOpportunity(orders);
     }
 
-    checkArbitrageOpportunity();
+    // the engine may call back into this strategy while matching the orders
+    for (const auto& order : orders) {
+        submit_(order);
+    }
 }
 
 void ArbitrageTrader::onTrade(const Trade& trade) {
@@ -114,32 +128,30 @@ void ArbitrageTrader::onTrade(const Trade& trade) {
     }
 }
 
-void ArbitrageTrader::checkArbitrageOpportunity() {
-    if (!best_ask_.count(symbol1_) || !best_bid_.count(symbol2_)) return;
-    if (!best_ask_.count(symbol2_) || !best_bid_.count(symbol1_)) return;
-
-    double ask1 = best_ask_[symbol1_];
-    double bid2 = best_bid_[symbol2_];
-    double ask2 = best_ask_[symbol2_];
-    double bid1 = best_bid_[symbol1_];
+void ArbitrageTrader::checkArbitrageOpportunity(std::vector<Order>& orders) {
+    const engine::TopOfBook& top1 = top_[0];
+    const engine::TopOfBook& top2 = top_[1];
+    if (!top1.hasBid() || !top1.hasAsk() || !top2.hasBid() || !top2.hasAsk()) return;
 
-    uint64_t now_us = static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+    double ask1 = top1.ask_price;
+    double bid2 = top2.bid_price;
+    double ask2 = top2.ask_price;
+    double bid1 = top1.bid_price;
 
-    double threshold = 0.05;  // Minimum profit spread
+    uint64_t now_us = clock().now();
+    uint32_t qty = static_cast<uint32_t>(order_size_);
 
     // Trade 1 -> Buy symbol1, sell symbol2
-    if ((bid2 - ask1) > threshold) {
-        submit_(Order(core::Order::global_order_id++, symbol1_, OrderType::LIMIT, Side::BUY, ask1, 10, now_us));
-        submit_(Order(core::Order::global_order_id++, symbol2_, OrderType::LIMIT, Side::SELL, bid2, 10, now_us));
+    if ((bid2 - ask1) > spread_) {
+        orders.emplace_back(core::Order::global_order_id++, symbol1_, OrderType::LIMIT, Side::BUY, ask1, qty, now_us);
+        orders.emplace_back(core::Order::global_order_id++, symbol2_, OrderType::LIMIT, Side::SELL, bid2, qty, now_us);
         std::cout << "[Arbitrage] Buy " << symbol1_ << " @ " << ask1 << ", Sell " << symbol2_ << " @ " << bid2 << std::endl;
     }
 
     // Trade 2 -> Buy symbol2, sell symbol1
-    if ((bid1 - ask2) > threshold) {
-        submit_(Order(core::Order::global_order_id++, symbol2_, OrderType::LIMIT, Side::BUY, ask2, 10, now_us));
-        submit_(Order(core::Order::global_order_id++, symbol1_, OrderType::LIMIT, Side::SELL, bid1, 10, now_us));
+    if ((bid1 - ask2) > spread_) {
+        orders.emplace_back(core::Order::global_order_id++, symbol2_, OrderType::LIMIT, Side::BUY, ask2, qty, now_us);
+        orders.emplace_back(core::Order::global_order_id++, symbol1_, OrderType::LIMIT, Side::SELL, bid1, qty, now_us);
         std::cout << "[Arbitrage] Buy " << symbol2_ << " @ " << ask2 << ", Sell " << symbol1_ << " @ " << bid1 << std::endl;
     }
 }
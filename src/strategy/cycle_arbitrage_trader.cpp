@@ -0,0 +1,124 @@
+/**
+ * @file cycle_arbitrage_trader.cpp
+ * @brief Implements cycle arbitrage over book events with an incrementally updated ArbitrageGraph.
+ */
+
+#include "strategy/cycle_arbitrage_trader.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace strategy {
+
+using namespace core;
+
+CycleArbitrageTrader::CycleArbitrageTrader(const std::vector<std::string>& pairs,
+                                           SubmitOrderCallback submit,
+                                           int order_size,
+                                           double min_profit,
+                                           double fee_rate,
+                                           std::size_t max_cycle_length)
+    : pairs_(pairs),
+      submit_(std::move(submit)),
+      order_size_(static_cast<uint32_t>(order_size)),
+      graph_(max_cycle_length, fee_rate, min_profit) {
+    for (const auto& pair : pairs_) {
+        graph_.addPair(pair);
+        subscribe(pair, TRADES | BOOK_UPDATES);
+    }
+    subscribeBookEvents();
+}
+
+void CycleArbitrageTrader::start() {
+    running_ = true;
+    std::cout << "[CycleArbitrageTrader] Started over " << graph_.pairCount() << " pairs, "
+              << graph_.cycleCount() << " cycles" << std::endl;
+}
+
+void CycleArbitrageTrader::stop() {
+    running_ = false;
+    std::cout << "[CycleArbitrageTrader] Stopped." << std::endl;
+}
+
+void CycleArbitrageTrader::onMarketData(const Order&) {
+    // prices come from onBookUpdate
+}
+
+void CycleArbitrageTrader::onBookUpdate(const engine::BookEvent& event) {
+    if (!running_ || !event.bbo_changed) return;
+
+    std::vector<Order> orders;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double bid = event.top.hasBid() ? event.top.bid_price : 0.0;
+        double ask = event.top.hasAsk() ? event.top.ask_price : 0.0;
+        found_.clear();
+        graph_.update(graph_.pairIndex(event.instrument), bid, ask, found_);
+
+        uint64_t now_us = clock().now();
+        for (const auto& opportunity : found_) {
+            std::cout << "[CycleArbitrage] Cycle " << opportunity.cycle << " profit " << opportunity.profit << ":";
+            for (const auto& leg : graph_.legs(opportunity.cycle)) {
+                double price = leg.side == Side::BUY ? graph_.ask(leg.pair) : graph_.bid(leg.pair);
+                orders.emplace_back(Order::global_order_id++, graph_.instrument(leg.pair), OrderType::LIMIT,
+                                    leg.side, price, order_size_, now_us);
+                own_orders_[orders.back().id] = leg.side;
+                std::cout << " " << (leg.side == Side::BUY ? "Buy " : "Sell ") << graph_.instrument(leg.pair)
+                          << " @ " << price;
+            }
+            std::cout << std::endl;
+            cycles_traded_++;
+        }
+    }
+
+    // the engine may call back into this strategy while matching the orders
+    for (const auto& order : orders) {
+        submit_(order);
+    }
+}
+
+void CycleArbitrageTrader::onTrade(const Trade& trade) {
+    if (!running_) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int qty = 0;
+    if (own_orders_.count(trade.buy_order_id)) qty += static_cast<int>(trade.quantity);
+    if (own_orders_.count(trade.sell_order_id)) qty -= static_cast<int>(trade.quantity);
+    if (qty == 0) return;
+
+    positions_[trade.instrument] += qty;
+    total_trades_++;
+    total_quantity_ += trade.quantity;
+}
+
+int CycleArbitrageTrader::getPosition(const std::string& instrument) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = positions_.find(instrument);
+    return it != positions_.end() ? it->second : 0;
+}
+
+void CycleArbitrageTrader::printSummary() const {
+    std::cout << "\n[SUMMARY] Cycle Arbitrage Strategy\n"
+              << "[SUMMARY] Cycles Traded: " << cycles_traded_ << "\n";
+    for (const auto& pair : pairs_) {
+        std::cout << "[SUMMARY] Position [" << pair << "]: " << getPosition(pair) << "\n";
+    }
+    std::cout << "[SUMMARY] Total Trades: " << totalTrades() << "\n"
+              << "[SUMMARY] Average Trade Size: " << averageTradeSize() << "\n";
+}
+
+void CycleArbitrageTrader::exportSummary(const std::string& path) const {
+    std::ofstream out(path);
+    out << "{\n";
+    out << "  \"strategy\": \"cycle\",\n";
+    out << "  \"cycles_traded\": " << cycles_traded_ << ",\n";
+    for (const auto& pair : pairs_) {
+        out << "  \"position_" << pair << "\": " << getPosition(pair) << ",\n";
+    }
+    out << "  \"total_trades\": " << totalTrades() << ",\n";
+    out << "  \"average_trade_size\": " << averageTradeSize() << "\n";
+    out << "}\n";
+    out.close();
+}
+
+}
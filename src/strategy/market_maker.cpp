@@ -4,6 +4,7 @@
  */
 
 #include "strategy/market_maker.hpp"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -20,35 +21,41 @@ MarketMaker::MarketMaker(
     engine::OrderBook& book,
     SubmitOrderCallback submit,
     double max_loss)
-    : inventory_limit_(10),
-      symbol_(symbol),
+    : symbol_(symbol),
       book_(book),
       submitOrder_(submit),
       running_(false),
+      quoting_model_(std::make_unique<SymmetricQuoting>()),
+      inventory_limit_(10),
       max_loss_(max_loss),
-      current_bid_id_(0),
-      current_ask_id_(0),
       total_quotes_(0),
-      total_trades_(0) {}
+      total_trades_(0) {
+    subscribe(symbol_);
+}
 
 void MarketMaker::start() {
     running_ = true;
-    metrics_log_.open("logs/market_maker_metrics.csv");
+    if (auto path = logPath("market_maker_metrics.csv"); !path.empty()) {
+        metrics_log_.open(path);
+    }
     if (metrics_log_.is_open()) {
         metrics_log_ << "timestamp,inventory,pnl,spread,bid_id,ask_id\n";
     }
-    trade_log_.open("logs/market_maker_trades.csv");
+    if (auto path = logPath("market_maker_trades.csv"); !path.empty()) {
+        trade_log_.open(path);
+    }
     if (trade_log_.is_open()) {
         trade_log_ << "trade_id,instrument,price,quantity,pnl,inventory,timestamp,risk_breached\n";
     }
-    worker_ = std::thread(&MarketMaker::run, this);
+    // refresh quotes every 500ms
+    quote_timer_ = clock().schedule(0, 500'000, [this] {
+        if (running_) placeQuotes();
+    });
 }
 
 void MarketMaker::stop() {
     running_ = false;
-    if (worker_.joinable()) {
-        worker_.join();
-    }
+    clock().cancel(quote_timer_);
     if (metrics_log_.is_open()) {
         metrics_log_.close();
     }
@@ -65,17 +72,54 @@ void MarketMaker::stop() {
 void MarketMaker::onMarketData(const Order& order) {
     if (order.instrument != symbol_) return;
     std::lock_guard<std::mutex> lock(market_mutex_);
-    recent_market_orders_.push_back(order);
-    if (recent_market_orders_.size() > 100) {
-        recent_market_orders_.erase(recent_market_orders_.begin());
+
+    // market ticks carry no price; they only count toward the flow
+    if (order.price > 0.0) {
+        for (std::size_t i = recent_ticks_.size(); i-- > 0;) {
+            if (recent_ticks_[i].price > 0.0) {
+                tick_returns_.add(order.price / recent_ticks_[i].price - 1.0);
+                break;
+            }
+        }
+    }
+
+    if (last_tick_ts_ != 0 && order.timestamp > last_tick_ts_) {
+        tick_interval_.add(static_cast<double>(order.timestamp - last_tick_ts_));
+    }
+    last_tick_ts_ = std::max(last_tick_ts_, order.timestamp);
+
+    auto evicted = recent_ticks_.push({order.timestamp, order.price, order.quantity, order.side});
+    (order.side == Side::BUY ? buy_volume_ : sell_volume_) += order.quantity;
+    if (evicted) {
+        (evicted->side == Side::BUY ? buy_volume_ : sell_volume_) -= evicted->quantity;
     }
 }
 
+void MarketMaker::setQuotingModel(std::unique_ptr<QuotingModel> model) {
+    quoting_model_ = std::move(model);
+}
+
+double MarketMaker::flowImbalance() const {
+    std::lock_guard<std::mutex> lock(market_mutex_);
+    double total = buy_volume_ + sell_volume_;
+    return total > 0.0 ? (buy_volume_ - sell_volume_) / total : 0.0;
+}
+
+double MarketMaker::shortTermVolatility() const {
+    std::lock_guard<std::mutex> lock(market_mutex_);
+    return tick_returns_.stddev();
+}
+
 void MarketMaker::onTrade(const Trade& trade) {
     if (trade.instrument != symbol_) return;
 
     total_trades_++;
 
+    if (quoted_mid_ > 0) {
+        std::lock_guard<std::mutex> lock(market_mutex_);
+        trade_depth_.add(std::abs(trade.price - quoted_mid_));
+    }
+
     std::lock_guard<std::mutex> lock(pnl_mutex_);
 
     auto it = active_orders_.find(trade.buy_order_id);
@@ -139,22 +183,43 @@ void MarketMaker::onTrade(const Trade& trade) {
 }
 
 
-std::string MarketMaker::name() const {
-    return "MarketMaker";
+void MarketMaker::onBookUpdate(const engine::BookEvent& event) {
+    if (!running_ || event.instrument != symbol_ || !event.bbo_changed) return;
+
+    // our own quotes sit around quoted_center_, so they can only pull the mid there
+    double mid = computeMidPrice(event.top);
+    if (mid < 0) return;
+    if (quoted_mid_ >= 0 && (std::abs(mid - quoted_mid_) <= max_price_drift_ ||
+                             std::abs(mid - quoted_center_) <= max_price_drift_)) {
+        return;
+    }
+
+    placeQuotes();
 }
 
-void MarketMaker::run() {
-    while (running_) {
-        placeQuotes();
-        std::this_thread::sleep_for(500ms); // refresh quote every 500ms
+void MarketMaker::onOrderRejected(const Order& order, engine::RejectReason reason) {
+    std::cout << "[MarketMaker] Order " << order.id << " rejected: " << engine::rejectReasonName(reason) << std::endl;
+
+    // free the level so the next placeQuotes() tries again
+    std::lock_guard<std::mutex> lock(pnl_mutex_);
+    active_orders_.erase(order.id);
+    filled_quantity_.erase(order.id);
+    for (auto* ids : {&bid_ids_, &ask_ids_}) {
+        for (auto& id : *ids) {
+            if (id == order.id) id = 0;
+        }
     }
 }
 
+std::string MarketMaker::name() const {
+    return "MarketMaker";
+}
+
 void MarketMaker::placeQuotes() {
-    // Order staleness and price drift thresholds
+    // Order staleness threshold
     const uint64_t max_age_us = 500'000; // 500ms
-    const double max_price_drift = 0.02; // max drift allowed
 
+    int inventory = 0;
     {
         std::lock_guard<std::mutex> lock(pnl_mutex_);
         if (realized_pnl_ <= max_loss_ || std::abs(inventory_) > inventory_limit_) {
@@ -164,96 +229,99 @@ void MarketMaker::placeQuotes() {
             return;
         }
         risk_violated_ = false;
+        inventory = inventory_;
     }
 
-    double mid = computeMidPrice();
-    if (mid < 0) return;
+    // one consistent BBO sample for the whole quote decision
+    const engine::TopOfBook top = book_.topOfBook();
 
-    // Log spread if both best bid and ask are available
-    auto best_bid = book_.getBestBid();
-    auto best_ask = book_.getBestAsk();
-    if (best_bid && best_ask) {
-        double spread = best_ask->price - best_bid->price;
-        std::cout << "Current spread: " << spread << std::endl;
-    }
+    double mid = computeMidPrice(top);
+    if (mid < 0) return;
+    quoted_mid_ = mid;
 
-    double spread = (best_bid && best_ask) ? std::max(0.01, (best_ask->price - best_bid->price) / 2.0) : 0.05;
-    double bid_price = mid - spread;
-    double ask_price = mid + spread;
+    std::cout << "Current spread: " << top.ask_price - top.bid_price << std::endl;
 
-    uint32_t qty = 1;
+    QuoteSet quotes;
+    quoting_model_->quote(marketState(top, mid, inventory), quotes);
+    if (quotes.bid_levels > 0 && quotes.ask_levels > 0) {
+        quoted_center_ = (quotes.bids[0].price + quotes.asks[0].price) / 2.0;
+    } else {
+        quoted_center_ = mid;
+    }
 
-    uint64_t ts = static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count());
+    uint64_t ts = clock().now();
 
     // Timestamp and staleness check logic
-    uint64_t now_us = static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count());
+    uint64_t now_us = ts;
 
-    auto cancel_if_stale = [&](uint64_t id, double new_price) {
+    auto cancel_if_stale = [&](uint64_t id, const QuoteLevel& level) {
         auto it = active_orders_.find(id);
         if (it == active_orders_.end()) return true;
 
         const Order& old = it->second;
         bool expired = now_us > old.timestamp + max_age_us;
-        bool price_moved = std::abs(old.price - new_price) > max_price_drift;
-        return expired || price_moved;
+        bool price_moved = std::abs(old.price - level.price) > max_price_drift_;
+        return expired || price_moved || old.quantity != level.quantity;
     };
 
-    if (cancel_if_stale(current_bid_id_, bid_price)) {
-        submitOrder_(Order(current_bid_id_, symbol_, OrderType::LIMIT, Side::BUY, 0.0, 0, 0));
-        active_orders_.erase(current_bid_id_);
-        filled_quantity_.erase(current_bid_id_);
-        current_bid_id_ = 0;
-    }
-
-    if (cancel_if_stale(current_ask_id_, ask_price)) {
-        submitOrder_(Order(current_ask_id_, symbol_, OrderType::LIMIT, Side::SELL, 0.0, 0, 0));
-        active_orders_.erase(current_ask_id_);
-        filled_quantity_.erase(current_ask_id_);
-        current_ask_id_ = 0;
-    }
-
-    if (current_bid_id_ == 0) {
-        Order bid = Order(order_id_counter_++, symbol_, OrderType::LIMIT, Side::BUY, bid_price, qty, ts);
-        submitOrder_(bid);
-        active_orders_[bid.id] = bid;
-        filled_quantity_[bid.id] = 0;
-        current_bid_id_ = bid.id;
-    }
-
-    if (current_ask_id_ == 0) {
-        Order ask = Order(order_id_counter_++, symbol_, OrderType::LIMIT, Side::SELL, ask_price, qty, ts);
-        submitOrder_(ask);
-        active_orders_[ask.id] = ask;
-        filled_quantity_[ask.id] = 0;
-        current_ask_id_ = ask.id;
-    }
+    // walk each ladder level by level; levels the model dropped are cancelled
+    auto requote = [&](std::array<uint64_t, QuoteSet::max_levels>& ids, Side side,
+                       const std::array<QuoteLevel, QuoteSet::max_levels>& levels, std::size_t count) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            bool wanted = i < count;
+            if (ids[i] != 0 && (!wanted || cancel_if_stale(ids[i], levels[i]))) {
+                submitOrder_(Order(ids[i], symbol_, OrderType::LIMIT, side, 0.0, 0, 0));
+                active_orders_.erase(ids[i]);
+                filled_quantity_.erase(ids[i]);
+                ids[i] = 0;
+            }
+            if (wanted && ids[i] == 0) {
+                Order quote(order_id_counter_++, symbol_, OrderType::LIMIT, side, levels[i].price, levels[i].quantity, ts);
+                submitOrder_(quote);
+                active_orders_[quote.id] = quote;
+                filled_quantity_[quote.id] = 0;
+                ids[i] = quote.id;
+            }
+        }
+    };
+    requote(bid_ids_, Side::BUY, quotes.bids, quotes.bid_levels);
+    requote(ask_ids_, Side::SELL, quotes.asks, quotes.ask_levels);
 
-    total_quotes_ += 2;
+    total_quotes_ += quotes.bid_levels + quotes.ask_levels;
 
     if (metrics_log_.is_open()) {
-        auto now = std::chrono::system_clock::now();
-        auto now_c = std::chrono::system_clock::to_time_t(now);
+        double spread = quotes.bid_levels > 0 && quotes.ask_levels > 0
+            ? (quotes.asks[0].price - quotes.bids[0].price) / 2.0 : 0.0;
+        auto now_c = static_cast<std::time_t>(ts / 1'000'000);
         metrics_log_ << std::put_time(std::localtime(&now_c), "%F %T") << ","
                      << inventory_ << "," << realized_pnl_ << "," << spread << ","
-                     << current_bid_id_ << "," << current_ask_id_ << "\n";
+                     << bid_ids_[0] << "," << ask_ids_[0] << "\n";
     }
 }
 
+MarketState MarketMaker::marketState(const engine::TopOfBook& top, double mid, int inventory) const {
+    MarketState state;
+    state.mid = mid;
+    state.book_half_spread = (top.ask_price - top.bid_price) / 2.0;
+    state.inventory = inventory;
+    state.inventory_limit = inventory_limit_;
+
+    std::lock_guard<std::mutex> lock(market_mutex_);
+    double volume = buy_volume_ + sell_volume_;
+    state.flow_imbalance = volume > 0.0 ? (buy_volume_ - sell_volume_) / volume : 0.0;
+    state.tick_volatility = tick_returns_.stddev();
+    state.tick_rate = tick_interval_.seeded() && tick_interval_.value() > 0.0 ? 1e6 / tick_interval_.value() : 0.0;
+    state.trade_depth = trade_depth_.seeded() ? trade_depth_.value() : 0.0;
+    return state;
+}
 
-double MarketMaker::computeMidPrice() {
-    auto best_bid = book_.getBestBid();
-    auto best_ask = book_.getBestAsk();
 
-    if (!best_bid || !best_ask) {
+double MarketMaker::computeMidPrice(const engine::TopOfBook& top) const {
+    if (!top.hasBid() || !top.hasAsk()) {
         return -1.0; // cannot compute mid without both sides
     }
 
-    return (best_bid->price + best_ask->price) / 2.0;
+    return (top.bid_price + top.ask_price) / 2.0;
 }
 
 void MarketMaker::printSummary() const {
@@ -4,38 +4,66 @@
  */
 
 #include "strategy/momentum_trader.hpp"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <stdexcept>
 
 namespace strategy {
 using namespace core;
 using namespace std::chrono_literals;
 
+namespace {
+
+template <typename T>
+void put(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void get(std::string_view& in, T& value) {
+    if (in.size() < sizeof(T)) {
+        throw std::runtime_error("Truncated MomentumTrader state");
+    }
+    std::memcpy(&value, in.data(), sizeof(T));
+    in.remove_prefix(sizeof(T));
+}
+
+}
+
 MomentumTrader::MomentumTrader(
     const std::string& symbol,
     SubmitOrderCallback submit,
-    double max_loss)
+    double max_loss,
+    std::size_t window)
     : symbol_(symbol),
       submitOrder_(submit),
       running_(false),
-      max_loss_(max_loss) {}
+      recent_prices_(window),
+      max_loss_(max_loss) {
+    subscribe(symbol_);
+}
 
 void MomentumTrader::start() {
     running_ = true;
-    trade_log_.open("logs/momentum_trades.csv");
+    if (auto path = logPath("momentum_trades.csv"); !path.empty()) {
+        trade_log_.open(path);
+    }
     if (trade_log_.is_open()) {
         trade_log_ << "trade_id,instrument,price,quantity,pnl,position,timestamp,risk_breached";
     }
-    worker_ = std::thread(&MomentumTrader::run, this);
+    if (bookEventsEnabled()) return;  // driven by onBookUpdate instead of polling
+    eval_timer_ = clock().schedule(0, 200'000, [this] {  // Check every 200ms
+        if (running_) evaluateMomentum();
+    });
 }
 
 void MomentumTrader::stop() {
     running_ = false;
-    if (worker_.joinable()) {
-        worker_.join();
-    }
+    clock().cancel(eval_timer_);
     if (trade_log_.is_open()) {
         trade_log_.close();
     }
@@ -45,10 +73,7 @@ void MomentumTrader::onMarketData(const Order& order) {
     if (order.instrument != symbol_) return;
 
     std::lock_guard<std::mutex> lock(data_mutex_);
-    recent_prices_.push_back(order.price);
-    if (recent_prices_.size() > 5) {
-        recent_prices_.erase(recent_prices_.begin());
-    }
+    recent_prices_.add(order.price);
 }
 
 void MomentumTrader::onTrade(const Trade& trade) {
@@ -84,29 +109,23 @@ void MomentumTrader::onTrade(const Trade& trade) {
     }
 }
 
-std::string MomentumTrader::name() const {
-    return "MomentumTrader";
+void MomentumTrader::onBookUpdate(const engine::BookEvent& event) {
+    if (!running_ || event.instrument != symbol_) return;
+    evaluateMomentum();
 }
 
-void MomentumTrader::run() {
-    while (running_) {
-        evaluateMomentum();
-        std::this_thread::sleep_for(200ms);  // Check every 200ms
-    }
+std::string MomentumTrader::name() const {
+    return "MomentumTrader";
 }
 
 void MomentumTrader::evaluateMomentum() {
-    std::lock_guard<std::mutex> lock(data_mutex_);
+    std::unique_lock<std::mutex> lock(data_mutex_);
 
     if (recent_prices_.size() < 3) return;
 
     // Simple momentum logic: last price > average of previous?
-    double current = recent_prices_.back();
-    double average = 0.0;
-    for (size_t i = 0; i < recent_prices_.size() - 1; ++i) {
-        average += recent_prices_[i];
-    }
-    average /= (recent_prices_.size() - 1);
+    double current = recent_prices_.window().back();
+    double average = (recent_prices_.sum() - current) / static_cast<double>(recent_prices_.size() - 1);
 
     uint64_t now = nowMicros();
     if (now < cooldown_end_ts_) return;  // still cooling down
@@ -115,21 +134,71 @@ void MomentumTrader::evaluateMomentum() {
     double price = current;
     uint32_t qty = 1;
 
-    Order order(Order::global_order_id++, symbol_, OrderType::MARKET, action, price, qty, now);    submitOrder_(order);
-
+    Order order(Order::global_order_id++, symbol_, OrderType::MARKET, action, price, qty, now);
     cooldown_end_ts_ = now + 1'000'000; // 1 second cooldown
+
+    // the engine may call back into this strategy while matching the order
+    lock.unlock();
+    submitOrder_(order);
+}
+
+void MomentumTrader::warmUp(std::span<const double> prices) {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    std::size_t keep = std::min(prices.size(), recent_prices_.window().capacity());
+    for (double price : prices.last(keep)) {
+        recent_prices_.add(price);
+    }
+}
+
+void MomentumTrader::saveState(std::string& out) const {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    const auto& prices = recent_prices_.window();
+    put(out, static_cast<uint32_t>(prices.size()));
+    for (std::size_t i = 0; i < prices.size(); ++i) put(out, prices[i]);
+    put(out, cooldown_end_ts_);
+    put(out, position_);
+    put(out, realized_pnl_);
+    put(out, peak_pnl_);
+    put(out, max_drawdown_);
+    put(out, static_cast<uint8_t>(risk_violated_));
+    put(out, static_cast<uint64_t>(total_trades_));
+    put(out, total_quantity_);
+}
+
+void MomentumTrader::restoreState(std::string_view state) {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    uint32_t count = 0;
+    get(state, count);
+    if (count > state.size() / sizeof(double)) {
+        throw std::runtime_error("Truncated MomentumTrader state");
+    }
+    recent_prices_.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        double price = 0.0;
+        get(state, price);
+        recent_prices_.add(price);
+    }
+    uint8_t risk_violated = 0;
+    uint64_t total_trades = 0;
+    get(state, cooldown_end_ts_);
+    get(state, position_);
+    get(state, realized_pnl_);
+    get(state, peak_pnl_);
+    get(state, max_drawdown_);
+    get(state, risk_violated);
+    get(state, total_trades);
+    get(state, total_quantity_);
+    risk_violated_ = risk_violated != 0;
+    total_trades_ = total_trades;
 }
 
 double MomentumTrader::getLatestPrice() const {
     std::lock_guard<std::mutex> lock(data_mutex_);
-    return recent_prices_.empty() ? -1.0 : recent_prices_.back();
+    return recent_prices_.size() == 0 ? -1.0 : recent_prices_.window().back();
 }
 
 uint64_t MomentumTrader::nowMicros() const {
-    return static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count());
+    return clock().now();
 }
 
 void MomentumTrader::printSummary() const {
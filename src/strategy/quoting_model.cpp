@@ -0,0 +1,63 @@
+/**
+ * @file quoting_model.cpp
+ * @brief Implements the symmetric and Avellaneda–Stoikov quoting models.
+ */
+
+#include "strategy/quoting_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace strategy {
+
+void SymmetricQuoting::quote(const MarketState& state, QuoteSet& out) const {
+    // widen in volatile markets and lean toward the side the flow is pushing
+    double spread = std::max({0.01, state.book_half_spread, vol_widen_ * state.tick_volatility * state.mid});
+    double center = state.mid + flow_skew_ * state.flow_imbalance * spread;
+    out.bids[0] = {center - spread, 1};
+    out.asks[0] = {center + spread, 1};
+    out.bid_levels = 1;
+    out.ask_levels = 1;
+}
+
+AvellanedaStoikovQuoting::AvellanedaStoikovQuoting(const Params& params) : params_(params) {
+    if (!(params.risk_aversion > 0.0)) {
+        throw std::invalid_argument("Avellaneda-Stoikov risk aversion must be positive");
+    }
+    if (params.levels == 0 || params.levels > QuoteSet::max_levels) {
+        throw std::invalid_argument("Avellaneda-Stoikov level count out of range");
+    }
+}
+
+void AvellanedaStoikovQuoting::quote(const MarketState& state, QuoteSet& out) const {
+    const double gamma = params_.risk_aversion;
+    double price_vol = state.tick_volatility * state.mid;
+    double risk = gamma * price_vol * price_vol * state.tick_rate * params_.horizon_s;
+
+    double reservation = state.mid - state.inventory * risk;
+
+    // without observed trades, assume fills thin out over the book's own half-spread
+    double depth = state.trade_depth > 0.0 ? state.trade_depth : state.book_half_spread;
+    double spread = risk;
+    if (depth > 0.0) {
+        spread += (2.0 / gamma) * std::log1p(gamma * depth);  // k = 1 / depth
+    }
+    double half = std::max(params_.min_half_spread, spread / 2.0);
+    double step = params_.level_spacing * half;
+
+    // quantities are capped by how far each side can move the position before the limit
+    auto ladder = [&](std::array<QuoteLevel, QuoteSet::max_levels>& levels, double sign, int headroom) {
+        std::size_t n = 0;
+        for (; n < params_.levels && headroom > 0; ++n) {
+            uint32_t qty = std::min<uint32_t>(params_.level_size, static_cast<uint32_t>(headroom));
+            levels[n] = {reservation + sign * (half + static_cast<double>(n) * step), qty};
+            headroom -= static_cast<int>(qty);
+        }
+        return n;
+    };
+    out.bid_levels = ladder(out.bids, -1.0, state.inventory_limit - state.inventory);
+    out.ask_levels = ladder(out.asks, 1.0, state.inventory_limit + state.inventory);
+}
+
+}
@@ -0,0 +1,149 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "strategy/arbitrage_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace strategy;
+using namespace core;
+
+TEST_CASE("ArbitrageGraph finds a profitable triangle once every leg is priced", "[arbitrage_graph]") {
+    ArbitrageGraph graph;
+    auto eth_usd = graph.addPair("ETH-USD");
+    auto btc_usd = graph.addPair("BTC-USD");
+    auto eth_btc = graph.addPair("ETH-BTC");
+    REQUIRE(graph.currencyCount() == 3);
+    REQUIRE(graph.cycleCount() == 2);  // the triangle in each direction
+
+    std::vector<ArbitrageOpportunity> found;
+    graph.update(eth_usd, 2000.0, 2001.0, found);
+    graph.update(btc_usd, 30000.0, 30010.0, found);
+    REQUIRE(found.empty());
+
+    // ETH -> BTC at 0.07 -> USD at 30000 buys back more than one ETH at 2001
+    graph.update(eth_btc, 0.07, 0.0701, found);
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0].profit == Catch::Approx(0.07 * 30000.0 / 2001.0 - 1.0));
+
+    auto legs = graph.legs(found[0].cycle);
+    REQUIRE(legs.size() == 3);
+    REQUIRE(graph.instrument(legs[0].pair) == "ETH-BTC");
+    REQUIRE(legs[0].side == Side::SELL);
+    REQUIRE(graph.instrument(legs[1].pair) == "BTC-USD");
+    REQUIRE(legs[1].side == Side::SELL);
+    REQUIRE(graph.instrument(legs[2].pair) == "ETH-USD");
+    REQUIRE(legs[2].side == Side::BUY);
+
+    // closing the gap removes it
+    found.clear();
+    graph.update(eth_btc, 0.0666, 0.0667, found);
+    REQUIRE(found.empty());
+}
+
+TEST_CASE("ArbitrageGraph applies fees and minimum profit to every leg", "[arbitrage_graph]") {
+    for (auto [fee, min_profit, expected] : {std::tuple{0.0, 0.0, 1u}, {0.02, 0.0, 0u}, {0.0, 0.05, 0u}}) {
+        ArbitrageGraph graph(3, fee, min_profit);
+        std::vector<ArbitrageOpportunity> found;
+        graph.update(graph.addPair("ETH-USD"), 2000.0, 2001.0, found);
+        graph.update(graph.addPair("BTC-USD"), 30000.0, 30010.0, found);
+        graph.update(graph.addPair("ETH-BTC"), 0.07, 0.0701, found);
+        REQUIRE(found.size() == expected);
+    }
+
+    // two venues quoting the same pair form a two-leg cycle when they cross
+    ArbitrageGraph venues(2);
+    std::vector<ArbitrageOpportunity> found;
+    venues.update(venues.addPair("ETH-USD@a", "ETH", "USD"), 2000.0, 2001.0, found);
+    venues.update(venues.addPair("ETH-USD@b", "ETH", "USD"), 2003.0, 2004.0, found);
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0].profit == Catch::Approx(2003.0 / 2001.0 - 1.0));
+
+    REQUIRE_THROWS_AS(venues.addPair("ETHUSD"), std::invalid_argument);
+    REQUIRE_THROWS_AS(venues.addPair("ETH-USD@a", "ETH", "USD"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ArbitrageGraph(7), std::invalid_argument);
+}
+
+TEST_CASE("ArbitrageGraph incremental updates agree with a full scan", "[arbitrage_graph]") {
+    const std::vector<std::string> coins{"USD", "BTC", "ETH", "SOL", "XRP", "ADA", "DOT", "LTC"};
+    const std::vector<double> value{1.0, 30000.0, 2000.0, 100.0, 0.5, 0.3, 6.0, 80.0};
+
+    ArbitrageGraph graph(4, 0.0005);
+    std::vector<std::size_t> pairs;
+    std::vector<double> fair;
+    for (std::size_t b = 1; b < coins.size(); ++b) {
+        for (std::size_t q = 0; q < b; ++q) {
+            pairs.push_back(graph.addPair(coins[b] + "-" + coins[q]));
+            fair.push_back(value[b] / value[q]);
+        }
+    }
+    pairs.push_back(graph.addPair("BTC-USD@b", "BTC", "USD"));
+    fair.push_back(value[1]);
+    pairs.push_back(graph.addPair("ETH-USD@b", "ETH", "USD"));
+    fair.push_back(value[2]);
+    REQUIRE(graph.pairCount() == 30);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<double> noise(0.0, 0.002);
+    std::uniform_int_distribution<std::size_t> pick(0, pairs.size() - 1);
+    std::vector<ArbitrageOpportunity> incremental, full;
+
+    auto quote = [&](std::size_t p) {
+        double mid = fair[p] * (1.0 + noise(rng));
+        graph.update(pairs[p], mid * 0.9995, mid * 1.0005, incremental);
+    };
+    for (std::size_t p = 0; p < pairs.size(); ++p) quote(p);
+
+    std::size_t opportunities = 0;
+    for (int i = 0; i < 5000; ++i) {
+        std::size_t p = pick(rng);
+        incremental.clear();
+        quote(p);
+
+        full.clear();
+        graph.profitableCycles(full);
+        std::vector<std::size_t> expected;
+        for (const auto& o : full) {
+            auto legs = graph.legs(o.cycle);
+            if (std::any_of(legs.begin(), legs.end(), [&](const CycleLeg& leg) { return leg.pair == pairs[p]; })) {
+                expected.push_back(o.cycle);
+            }
+        }
+        std::vector<std::size_t> got;
+        for (const auto& o : incremental) got.push_back(o.cycle);
+        std::sort(expected.begin(), expected.end());
+        std::sort(got.begin(), got.end());
+        REQUIRE(got == expected);
+        opportunities += got.size();
+    }
+    REQUIRE(opportunities > 0);
+}
+
+TEST_CASE("ArbitrageGraph updates stay under ten microseconds with 30 pairs", "[arbitrage_graph][.benchmark]") {
+    const std::vector<std::string> coins{"USD", "BTC", "ETH", "SOL", "XRP", "ADA", "DOT", "LTC"};
+    ArbitrageGraph graph(4);
+    std::vector<std::size_t> pairs;
+    for (std::size_t b = 1; b < coins.size(); ++b) {
+        for (std::size_t q = 0; q < b; ++q) pairs.push_back(graph.addPair(coins[b] + "-" + coins[q]));
+    }
+    pairs.push_back(graph.addPair("BTC-USD@b", "BTC", "USD"));
+    pairs.push_back(graph.addPair("ETH-USD@b", "ETH", "USD"));
+
+    std::vector<ArbitrageOpportunity> found;
+    found.reserve(4096);
+    const int runs = 100'000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        found.clear();
+        double price = 1.0 + 0.001 * (i % 7);
+        graph.update(pairs[i % pairs.size()], price, price * 1.001, found);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    REQUIRE(std::chrono::duration<double, std::micro>(elapsed).count() / runs < 10.0);
+}
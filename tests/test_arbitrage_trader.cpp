@@ -5,6 +5,7 @@
 #include "strategy/arbitrage_trader.hpp"
 #include "core/order.hpp"
 #include "core/trade.hpp"
+#include "engine/simulator.hpp"
 
 using namespace strategy;
 using namespace core;
@@ -75,4 +76,65 @@ TEST_CASE("ArbitrageTrader ignores irrelevant trades", "[arbitrage]") {
     REQUIRE(trader.getPosition("ETH-USD") == 0);
     REQUIRE(trader.getPosition("BTC-USD") == 0);
     REQUIRE(trader.getRealizedPnL() == Catch::Approx(0.0));
-}
\ No newline at end of file
+}
+TEST_CASE("ArbitrageTrader trades on the current BBO, not the best price ever seen", "[arbitrage]") {
+    engine::Simulator simulator;
+    std::vector<Order> submitted;
+    auto trader = std::make_shared<ArbitrageTrader>(
+        "ETH-USD", "BTC-USD",
+        [&](const Order& o) { submitted.push_back(o); }, 0.03, 15, -1000.0);
+    trader->setLogDirectory("");
+    simulator.registerStrategy(trader);
+    trader->start();
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 99.0, 1, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.5, 1, 1001});
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 98.0, 1, 1002});
+    simulator.onMarketData(Order{4, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 1, 1003});  // takes the 99 ask
+
+    // 100 - 99 would have looked like an opportunity; the live ask is 100.5
+    simulator.onMarketData(Order{5, "BTC-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1004});
+    simulator.onMarketData(Order{6, "BTC-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1005});
+    REQUIRE(submitted.empty());
+
+    // a BTC bid above the live ETH ask by less than the 0.03 spread is not enough
+    simulator.onMarketData(Order{7, "BTC-USD", OrderType::LIMIT, Side::BUY, 100.52, 1, 1006});
+    REQUIRE(submitted.empty());
+
+    // one clearing it by more is real, and trades the configured size
+    simulator.onMarketData(Order{8, "BTC-USD", OrderType::LIMIT, Side::BUY, 100.6, 1, 1007});
+    REQUIRE(submitted.size() == 2);
+    REQUIRE(submitted[0].instrument == "ETH-USD");
+    REQUIRE(submitted[0].side == Side::BUY);
+    REQUIRE(submitted[0].price == 100.5);
+    REQUIRE(submitted[0].quantity == 15);
+    REQUIRE(submitted[1].instrument == "BTC-USD");
+    REQUIRE(submitted[1].price == 100.6);
+    REQUIRE(submitted[1].quantity == 15);
+
+    trader->stop();
+}
+
+TEST_CASE("ArbitrageTrader submits through the simulator without re-entering its lock", "[arbitrage]") {
+    engine::Simulator simulator;
+    auto trader = std::make_shared<ArbitrageTrader>(
+        "ETH-USD", "BTC-USD", simulator.makeSubmitter(1), 0.03, 2, -1000.0);
+    trader->setLogDirectory("");
+    simulator.registerStrategy(trader, 1);
+    simulator.start();
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, 1001});
+    simulator.onMarketData(Order{3, "BTC-USD", OrderType::LIMIT, Side::SELL, 102.0, 5, 1002});
+
+    // the crossing bid makes the trader take the ETH ask and hit this bid;
+    // both fills reach onTrade on this thread while the submit is in progress
+    simulator.onMarketData(Order{4, "BTC-USD", OrderType::LIMIT, Side::BUY, 101.0, 2, 1003});
+    simulator.stop();
+
+    REQUIRE(trader->totalTrades() == 2);
+    REQUIRE(trader->getPosition("ETH-USD") == 2);
+    REQUIRE(trader->getPosition("BTC-USD") == -2);
+    REQUIRE_FALSE(simulator.getBook("ETH-USD").topOfBook().hasAsk());
+    REQUIRE_FALSE(simulator.getBook("BTC-USD").topOfBook().hasBid());
+}
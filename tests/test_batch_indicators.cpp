@@ -0,0 +1,135 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "core/batch_indicators.hpp"
+#include "core/indicators.hpp"
+#include "engine/journal.hpp"
+#include "engine/tick_columns.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+std::vector<double> randomWalk(std::size_t n, unsigned seed = 7) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> step(0.0, 0.5);
+    std::vector<double> prices;
+    double price = 100.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        price += step(rng);
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+// Runs @p kernel with the AVX2 path on (where available) and off.
+template <typename Kernel>
+void onBothPaths(Kernel kernel) {
+    bool simd = batch::simdEnabled();
+    kernel();
+    batch::setSimdEnabled(false);
+    kernel();
+    batch::setSimdEnabled(simd);
+}
+
+}
+
+TEST_CASE("Batch rolling sums match the incremental indicators", "[batch]") {
+    auto prices = randomWalk(1003);  // not a multiple of the vector width
+    std::vector<int64_t> ticks(prices.size());
+    for (std::size_t i = 0; i < prices.size(); ++i) ticks[i] = std::llround(prices[i] * 100.0);
+
+    for (std::size_t window : {1u, 3u, 4u, 7u, 64u, 2000u}) {
+        onBothPaths([&] {
+            std::vector<double> sums(prices.size());
+            batch::rollingSum(prices, window, sums);
+            std::vector<int64_t> tick_sums(ticks.size());
+            batch::rollingSum(ticks, window, tick_sums);
+
+            RollingStats stats(window);
+            int64_t exact = 0;
+            for (std::size_t i = 0; i < prices.size(); ++i) {
+                stats.add(prices[i]);
+                exact += ticks[i] - (i >= window ? ticks[i - window] : 0);
+                REQUIRE(sums[i] == Catch::Approx(stats.sum()).epsilon(1e-9));
+                REQUIRE(tick_sums[i] == exact);
+            }
+        });
+    }
+
+    std::vector<double> out(3);
+    REQUIRE_THROWS_AS(batch::rollingSum(prices, 5, out), std::invalid_argument);
+}
+
+TEST_CASE("Batch EMA and returns match per-tick computation", "[batch]") {
+    auto prices = randomWalk(517);
+    onBothPaths([&] {
+        std::vector<double> ema(prices.size()), simple(prices.size()), logs(prices.size());
+        batch::ema(prices, 0.1, ema);
+        batch::returns(prices, simple);
+        batch::logReturns(prices, logs);
+
+        Ema incremental(0.1);
+        for (std::size_t i = 0; i < prices.size(); ++i) {
+            incremental.add(prices[i]);
+            REQUIRE(ema[i] == Catch::Approx(incremental.value()).epsilon(1e-12));
+            if (i > 0) {
+                REQUIRE(simple[i] == Catch::Approx(prices[i] / prices[i - 1] - 1.0).margin(1e-15));
+                REQUIRE(logs[i] == Catch::Approx(std::log(prices[i] / prices[i - 1])).margin(1e-15));
+            }
+        }
+        REQUIRE(simple[0] == 0.0);
+    });
+}
+
+TEST_CASE("Batch cross-correlation finds the lead of one series over another", "[batch]") {
+    auto x = randomWalk(2000, 1);
+    std::vector<double> rx(x.size());
+    batch::returns(x, rx);
+
+    // y leads x by 3 steps: x[t] = y[t - 3]
+    auto noise = randomWalk(rx.size() + 3, 2);
+    std::vector<double> ry(rx.size());
+    for (std::size_t t = 0; t < ry.size(); ++t) {
+        ry[t] = t + 3 < rx.size() ? rx[t + 3] : noise[t] * 1e-3;
+    }
+
+    onBothPaths([&] {
+        REQUIRE(batch::correlation(rx, rx) == Catch::Approx(1.0));
+        std::vector<double> negated(rx.size());
+        for (std::size_t i = 0; i < rx.size(); ++i) negated[i] = -rx[i];
+        REQUIRE(batch::correlation(rx, negated) == Catch::Approx(-1.0));
+
+        std::vector<double> by_lag(8);
+        batch::crossCorrelation(rx, ry, by_lag);
+        std::size_t best = 0;
+        for (std::size_t lag = 1; lag < by_lag.size(); ++lag) {
+            if (by_lag[lag] > by_lag[best]) best = lag;
+        }
+        REQUIRE(best == 3);
+        REQUIRE(by_lag[3] > 0.99);
+    });
+}
+
+TEST_CASE("Journal ticks load into per-instrument columns", "[batch]") {
+    auto path = (std::filesystem::temp_directory_path() / "tradeit_columns.journal").string();
+    {
+        engine::JournalWriter writer(path);
+        writer.append(engine::JournalEvent::TICK, 1, Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 2, 1));
+        writer.append(engine::JournalEvent::STRATEGY_ORDER, 2, Order(2, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 1, 2));
+        writer.append(engine::JournalEvent::TICK, 3, Order(3, "BTC-USD", OrderType::LIMIT, Side::SELL, 20000.0, 1, 3));
+        writer.append(engine::JournalEvent::TICK, 4, Order(4, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 5, 4));
+    }
+
+    auto columns = engine::loadTickColumns(path);
+    REQUIRE(columns.size() == 2);
+    REQUIRE(columns["ETH-USD"].prices == std::vector<double>{100.0, 101.0});
+    REQUIRE(columns["ETH-USD"].quantities == std::vector<double>{2.0, 5.0});
+    REQUIRE(columns["BTC-USD"].timestamps == std::vector<uint64_t>{3});
+}
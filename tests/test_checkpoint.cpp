@@ -0,0 +1,192 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/checkpoint.hpp"
+#include "engine/journal.hpp"
+#include "engine/simulator.hpp"
+#include "strategy/momentum_trader.hpp"
+#include "core/order.hpp"
+#include "test_support.hpp"
+
+#include <fstream>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+using namespace test_support;
+
+namespace {
+
+Order limit(uint64_t id, Side side, double price, uint32_t qty, uint64_t ts, uint32_t display = 0) {
+    Order order(id, "ETH-USD", OrderType::LIMIT, side, price, qty, ts);
+    order.display_quantity = display;
+    order.owner_id = static_cast<uint32_t>(id % 3);
+    return order;
+}
+
+}
+
+TEST_CASE("Restored book keeps queue priority and iceberg reserves", "[checkpoint]") {
+    OrderBook original("ETH-USD");
+    original.addOrder(limit(1, Side::BUY, 99.0, 5, 1));
+    original.addOrder(limit(2, Side::BUY, 99.0, 3, 2));
+    original.addOrder(limit(3, Side::BUY, 98.5, 4, 3));
+    original.addOrder(limit(4, Side::SELL, 101.0, 10, 4, 2));  // iceberg, shows 2
+    original.addOrder(limit(5, Side::SELL, 101.0, 1, 5));
+    original.addOrder(limit(6, Side::SELL, 102.0, 7, 6));
+    original.addOrder(Order(7, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 2, 7));  // a trade before the checkpoint
+
+    std::vector<RestingOrder> storage;
+    BookState state = original.saveState(storage);
+    REQUIRE(state.orders.size() == 6);
+    REQUIRE(state.next_trade_id == 2);
+
+    OrderBook restored("ETH-USD");
+    restored.addOrder(limit(99, Side::BUY, 50.0, 1, 0));  // replaced by the restore
+    restored.restoreState(state);
+
+    REQUIRE(restored.getOrders().size() == original.getOrders().size());
+    REQUIRE(restored.topOfBook().bid_price == original.topOfBook().bid_price);
+    REQUIRE(restored.topOfBook().ask_size == original.topOfBook().ask_size);
+    REQUIRE(restored.topOfBook().sequence == original.topOfBook().sequence);
+
+    // the same flow afterwards trades identically, clip replenishment included
+    std::vector<Order> flow = {
+        Order(8, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 9, 8),
+        Order(9, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 6, 9),
+        limit(10, Side::BUY, 102.0, 6, 10),
+    };
+    for (const auto& order : flow) {
+        auto expected = original.addOrder(order);
+        auto actual = restored.addOrder(order);
+        REQUIRE(actual.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(actual[i].trade_id == expected[i].trade_id);
+            REQUIRE(actual[i].buy_order_id == expected[i].buy_order_id);
+            REQUIRE(actual[i].sell_order_id == expected[i].sell_order_id);
+            REQUIRE(actual[i].price == expected[i].price);
+            REQUIRE(actual[i].quantity == expected[i].quantity);
+        }
+    }
+
+    DepthSnapshot a, b;
+    original.depthSnapshot(10, a);
+    restored.depthSnapshot(10, b);
+    REQUIRE(a.asks.size() == b.asks.size());
+    for (std::size_t i = 0; i < a.asks.size(); ++i) {
+        REQUIRE(a.asks[i].quantity == b.asks[i].quantity);
+        REQUIRE(a.asks[i].order_count == b.asks[i].order_count);
+    }
+}
+
+TEST_CASE("Replay resumes from a checkpoint at its journal position", "[checkpoint]") {
+    auto journal_path = tempPath("tradeit_resume.journal");
+    auto checkpoint_path = tempPath("tradeit_resume.checkpoint");
+    auto ticks = choppyTicks();
+    {
+        Simulator simulator;
+        simulator.setOrderEntryLatency(std::make_unique<FixedLatency>(300));
+        simulator.setJournal(std::make_shared<JournalWriter>(journal_path));
+        auto trader = std::make_shared<MomentumTrader>("ETH-USD", simulator.makeSubmitter(1), -1e9);
+        trader->setLogDirectory("");
+        simulator.registerStrategy(trader);
+        simulator.start();
+        for (const auto& tick : ticks) {
+            simulator.onMarketData(tick);
+        }
+        simulator.stop();
+    }
+
+    // full replay, checkpointing half way
+    auto full_tape = std::make_shared<TradeTape>();
+    Simulator full;
+    full.registerStrategy(full_tape);
+    std::size_t trades_at_checkpoint = 0;
+    {
+        JournalReader reader(journal_path);
+        JournalRecord record;
+        while (reader.next(record)) {
+            full.replay(record);
+            if (record.sequence == 150) {
+                full.saveCheckpoint(checkpoint_path);
+                trades_at_checkpoint = full_tape->trades.size();
+            }
+        }
+    }
+    REQUIRE(full.journalPosition() > 151);
+    REQUIRE(trades_at_checkpoint > 0);
+
+    auto resumed_tape = std::make_shared<TradeTape>();
+    Simulator resumed;
+    resumed.registerStrategy(resumed_tape);
+    uint64_t offset = resumed.restoreCheckpoint(checkpoint_path);
+    REQUIRE(offset == 151);
+
+    JournalReader reader(journal_path);
+    REQUIRE(reader.skipTo(offset));
+    JournalRecord record;
+    REQUIRE(reader.next(record));
+    REQUIRE(record.sequence == offset);
+    resumed.replay(record);
+    while (reader.next(record)) {
+        resumed.replay(record);
+    }
+
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t, double, uint32_t>> tail(
+        full_tape->trades.begin() + static_cast<std::ptrdiff_t>(trades_at_checkpoint), full_tape->trades.end());
+    REQUIRE(resumed_tape->trades == tail);
+    REQUIRE(resumed.journalPosition() == full.journalPosition());
+
+    DepthSnapshot a, b;
+    full.getBook("ETH-USD").depthSnapshot(10, a);
+    resumed.getBook("ETH-USD").depthSnapshot(10, b);
+    REQUIRE(a.bids.size() == b.bids.size());
+    REQUIRE(a.asks.size() == b.asks.size());
+    for (std::size_t i = 0; i < a.bids.size(); ++i) {
+        REQUIRE(a.bids[i].price == b.bids[i].price);
+        REQUIRE(a.bids[i].quantity == b.bids[i].quantity);
+    }
+}
+
+TEST_CASE("Checkpoint carries strategy state", "[checkpoint]") {
+    auto path = tempPath("tradeit_strategy.checkpoint");
+    auto ticks = choppyTicks();
+
+    Simulator simulator;
+    auto trader = std::make_shared<MomentumTrader>("ETH-USD", simulator.makeSubmitter(1), -1e9);
+    trader->setLogDirectory("");
+    simulator.registerStrategy(trader);
+    simulator.start();
+    for (const auto& tick : ticks) {
+        simulator.onMarketData(tick);
+    }
+    simulator.stop();
+    REQUIRE(trader->totalTrades() > 0);
+    simulator.saveCheckpoint(path);
+
+    Simulator resumed;
+    auto restored = std::make_shared<MomentumTrader>("ETH-USD", resumed.makeSubmitter(1), -1e9);
+    resumed.registerStrategy(restored);
+    resumed.restoreCheckpoint(path);
+    REQUIRE(restored->totalTrades() == trader->totalTrades());
+    REQUIRE(restored->realizedPnL() == trader->realizedPnL());
+    REQUIRE(restored->maxDrawdown() == trader->maxDrawdown());
+    REQUIRE(resumed.clock().now() == simulator.clock().now());
+
+    // a different line-up of strategies cannot take the checkpoint
+    Simulator other;
+    other.registerStrategy(std::make_shared<TradeTape>());
+    REQUIRE_THROWS_AS(other.restoreCheckpoint(path), std::runtime_error);
+}
+
+TEST_CASE("Checkpoint reader rejects files that are not checkpoints", "[checkpoint]") {
+    auto path = tempPath("tradeit_not_a.checkpoint");
+    std::ofstream(path) << "timestamp,instrument,side,price,quantity\n";
+    REQUIRE_THROWS_AS(MappedCheckpoint(path), std::runtime_error);
+
+    std::ofstream(path, std::ios::trunc) << "TRDCKPT";
+    REQUIRE_THROWS_AS(MappedCheckpoint(path), std::runtime_error);
+}
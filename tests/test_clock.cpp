@@ -0,0 +1,95 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/clock.hpp"
+#include "engine/simulator.hpp"
+#include "strategy/momentum_trader.hpp"
+#include "core/order.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+
+TEST_CASE("SimulationClock fires timers in due order at their due time", "[clock]") {
+    SimulationClock clock;
+    std::vector<std::pair<int, uint64_t>> fired;
+
+    clock.schedule(0, 100, [&] { fired.push_back({1, clock.now()}); });
+    clock.schedule(50, 0, [&] { fired.push_back({2, clock.now()}); });
+
+    // first advance anchors the timers scheduled before replay began
+    clock.advanceTo(1000);
+    REQUIRE(fired == std::vector<std::pair<int, uint64_t>>{{1, 1000}});
+
+    clock.advanceTo(1250);
+    REQUIRE(fired == std::vector<std::pair<int, uint64_t>>{
+        {1, 1000}, {2, 1050}, {1, 1100}, {1, 1200}});
+    REQUIRE(clock.now() == 1250);
+    REQUIRE(clock.nextTimerDue() == 1300);
+
+    // time never moves backwards
+    clock.advanceTo(10);
+    REQUIRE(clock.now() == 1250);
+}
+
+TEST_CASE("SimulationClock cancel stops a periodic timer", "[clock]") {
+    SimulationClock clock;
+    int calls = 0;
+    TimerId id = clock.schedule(0, 10, [&] { ++calls; });
+
+    clock.advanceTo(100);
+    REQUIRE(calls == 1);
+    clock.advanceTo(125);
+    REQUIRE(calls == 3);
+
+    clock.cancel(id);
+    clock.advanceTo(1000);
+    REQUIRE(calls == 3);
+    REQUIRE_FALSE(clock.nextTimerDue().has_value());
+}
+
+TEST_CASE("RealTimeClock fires timers on its own thread", "[clock]") {
+    RealTimeClock clock;
+    std::atomic<int> calls{0};
+
+    TimerId id = clock.schedule(0, 5'000, [&] { ++calls; });
+    for (int i = 0; i < 200 && calls < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    clock.cancel(id);
+
+    int after_cancel = calls;
+    REQUIRE(after_cancel >= 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(calls == after_cancel);
+}
+
+TEST_CASE("MomentumTrader evaluates on simulated time", "[clock][momentum]") {
+    Simulator simulator;
+    std::vector<Order> submitted;
+
+    auto trader = std::make_shared<MomentumTrader>("ETH-USD",
+        [&](const Order& o) { submitted.push_back(o); },
+        -500.0);
+    simulator.registerStrategy(trader);
+    simulator.start();
+
+    const uint64_t t0 = 1'000'000;
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, t0});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 1, t0 + 100'000});
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 103.0, 1, t0 + 150'000});
+    REQUIRE(submitted.empty());
+
+    // the 200ms evaluation fires between the third and fourth tick
+    simulator.onMarketData(Order{4, "ETH-USD", OrderType::LIMIT, Side::BUY, 103.0, 1, t0 + 250'000});
+    simulator.stop();
+
+    REQUIRE(submitted.size() == 1);
+    REQUIRE(submitted[0].side == Side::BUY);
+    REQUIRE(submitted[0].timestamp == t0 + 200'000);
+}
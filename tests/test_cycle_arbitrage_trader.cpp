@@ -0,0 +1,57 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "strategy/cycle_arbitrage_trader.hpp"
+#include "engine/simulator.hpp"
+
+using namespace strategy;
+using namespace core;
+
+TEST_CASE("CycleArbitrageTrader trades a triangular cycle from book events", "[arbitrage_graph][arbitrage]") {
+    engine::Simulator simulator;
+    auto trader = std::make_shared<CycleArbitrageTrader>(
+        std::vector<std::string>{"ETH-USD", "BTC-USD", "ETH-BTC"}, simulator.makeSubmitter(1), 1, 0.001);
+    trader->setLogDirectory("");
+    simulator.registerStrategy(trader, 1);
+    simulator.start();
+
+    simulator.onMarketData(Order{1000001, "ETH-USD", OrderType::LIMIT, Side::BUY, 2000.0, 1, 1000});
+    simulator.onMarketData(Order{1000002, "ETH-USD", OrderType::LIMIT, Side::SELL, 2001.0, 1, 1001});
+    simulator.onMarketData(Order{1000003, "BTC-USD", OrderType::LIMIT, Side::BUY, 30000.0, 1, 1002});
+    simulator.onMarketData(Order{1000004, "BTC-USD", OrderType::LIMIT, Side::SELL, 30010.0, 1, 1003});
+    simulator.onMarketData(Order{1000005, "ETH-BTC", OrderType::LIMIT, Side::SELL, 0.072, 1, 1004});
+    REQUIRE(trader->cyclesTraded() == 0);
+
+    // USD -> ETH at 2001, ETH -> BTC at 0.07, BTC -> USD at 30000 returns about 5%
+    simulator.onMarketData(Order{1000006, "ETH-BTC", OrderType::LIMIT, Side::BUY, 0.07, 1, 1005});
+    simulator.stop();
+
+    REQUIRE(trader->cyclesTraded() == 1);
+    REQUIRE(trader->totalTrades() == 3);
+    REQUIRE(trader->getPosition("ETH-USD") == 1);
+    REQUIRE(trader->getPosition("ETH-BTC") == -1);
+    REQUIRE(trader->getPosition("BTC-USD") == -1);
+    REQUIRE_FALSE(simulator.getBook("ETH-USD").topOfBook().hasAsk());
+}
+
+TEST_CASE("CycleArbitrageTrader ignores cycles below its minimum profit", "[arbitrage_graph][arbitrage]") {
+    engine::Simulator simulator;
+    std::vector<Order> submitted;
+    auto trader = std::make_shared<CycleArbitrageTrader>(
+        std::vector<std::string>{"ETH-USD", "BTC-USD", "ETH-BTC"},
+        [&](const Order& o) { submitted.push_back(o); }, 1, 0.1);
+    trader->setLogDirectory("");
+    simulator.registerStrategy(trader);
+    trader->start();
+
+    simulator.onMarketData(Order{1000001, "ETH-USD", OrderType::LIMIT, Side::BUY, 2000.0, 1, 1000});
+    simulator.onMarketData(Order{1000002, "ETH-USD", OrderType::LIMIT, Side::SELL, 2001.0, 1, 1001});
+    simulator.onMarketData(Order{1000003, "BTC-USD", OrderType::LIMIT, Side::BUY, 30000.0, 1, 1002});
+    simulator.onMarketData(Order{1000004, "BTC-USD", OrderType::LIMIT, Side::SELL, 30010.0, 1, 1003});
+    simulator.onMarketData(Order{1000005, "ETH-BTC", OrderType::LIMIT, Side::SELL, 0.072, 1, 1004});
+    simulator.onMarketData(Order{1000006, "ETH-BTC", OrderType::LIMIT, Side::BUY, 0.07, 1, 1005});
+    trader->stop();
+
+    REQUIRE(submitted.empty());
+    REQUIRE_THROWS_AS(CycleArbitrageTrader({"ETHUSD"}, [](const Order&) {}, 1, 0.0), std::invalid_argument);
+}
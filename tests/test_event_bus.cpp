@@ -0,0 +1,85 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/event_bus.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+struct Slot {
+    int64_t value = 0;
+    int64_t doubled = 0;
+    int64_t tripled = 0;
+};
+
+}
+
+TEST_CASE("RingBuffer rejects capacities that are not a power of two", "[event_bus]") {
+    REQUIRE_THROWS_AS(RingBuffer<Slot>(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(RingBuffer<Slot>(48), std::invalid_argument);
+    REQUIRE(RingBuffer<Slot>(64).capacity() == 64);
+}
+
+TEST_CASE("A consumer sees every event in order across many wraps", "[event_bus]") {
+    RingBuffer<Slot> ring(16);
+    std::vector<int64_t> seen;
+    BatchEventProcessor consumer(ring, {}, [&](Slot& slot, int64_t, bool) { seen.push_back(slot.value); });
+    ring.addGatingSequences({&consumer.sequence()});
+
+    std::thread worker([&] { consumer.run(); });
+    for (int64_t i = 0; i < 10'000; ++i) {
+        ring.publishEvent([i](Slot& slot) { slot.value = i; });
+    }
+    ring.drain();
+    consumer.halt();
+    worker.join();
+
+    REQUIRE(seen.size() == 10'000);
+    for (int64_t i = 0; i < 10'000; ++i) {
+        REQUIRE(seen[static_cast<std::size_t>(i)] == i);
+    }
+}
+
+TEST_CASE("A dependent stage only reads events both upstream stages finished", "[event_bus]") {
+    RingBuffer<Slot> ring(64);
+
+    // two independent stages annotate each slot, a third reads both results
+    BatchEventProcessor doubler(ring, {}, [](Slot& slot, int64_t, bool) { slot.doubled = slot.value * 2; });
+    BatchEventProcessor tripler(ring, {}, [](Slot& slot, int64_t, bool) { slot.tripled = slot.value * 3; });
+    std::atomic<int64_t> mismatches{0};
+    int64_t sum = 0;
+    BatchEventProcessor summer(ring, {&doubler.sequence(), &tripler.sequence()}, [&](Slot& slot, int64_t, bool) {
+        if (slot.doubled != slot.value * 2 || slot.tripled != slot.value * 3) ++mismatches;
+        sum += slot.doubled + slot.tripled;
+    });
+    ring.addGatingSequences({&summer.sequence()});
+
+    std::thread t1([&] { doubler.run(); });
+    std::thread t2([&] { tripler.run(); });
+    std::thread t3([&] { summer.run(); });
+
+    const int64_t count = 20'000;
+    for (int64_t i = 1; i <= count; ++i) {
+        ring.publishEvent([i](Slot& slot) { slot.value = i; });
+    }
+    ring.drain();
+    for (auto* stage : {&doubler.sequence(), &tripler.sequence()}) {
+        REQUIRE(stage->get() == count - 1);
+    }
+    doubler.halt();
+    tripler.halt();
+    summer.halt();
+    t1.join();
+    t2.join();
+    t3.join();
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(sum == 5 * count * (count + 1) / 2);
+}
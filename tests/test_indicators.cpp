@@ -0,0 +1,108 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "core/indicators.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+std::vector<double> randomWalk(std::size_t n) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> step(0.0, 0.5);
+    std::vector<double> prices;
+    double price = 100.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        price += step(rng);
+        prices.push_back(price);
+    }
+    return prices;
+}
+
+}
+
+TEST_CASE("FixedRing keeps the newest values and returns evictions", "[indicators]") {
+    FixedRing<int> ring(3);
+    REQUIRE_FALSE(ring.push(1));
+    REQUIRE_FALSE(ring.push(2));
+    REQUIRE_FALSE(ring.push(3));
+    REQUIRE(ring.full());
+
+    auto evicted = ring.push(4);
+    REQUIRE(evicted);
+    REQUIRE(*evicted == 1);
+    REQUIRE(ring.front() == 2);
+    REQUIRE(ring.back() == 4);
+    REQUIRE(ring[1] == 3);
+
+    ring.popBack();
+    ring.popFront();
+    REQUIRE(ring.size() == 1);
+    REQUIRE(ring.front() == 3);
+
+    REQUIRE_THROWS_AS(FixedRing<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("Rolling indicators match a brute-force recomputation", "[indicators]") {
+    const std::size_t window = 50;
+    auto prices = randomWalk(2000);
+
+    RollingStats stats(window);
+    RollingMin low(window);
+    RollingMax high(window);
+    RollingVwap vwap(window);
+    RollingZScore z(window);
+
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        double quantity = 1.0 + static_cast<double>(i % 7);
+        stats.add(prices[i]);
+        low.add(prices[i]);
+        high.add(prices[i]);
+        vwap.add(prices[i], quantity);
+        z.add(prices[i]);
+
+        std::size_t first = i + 1 > window ? i + 1 - window : 0;
+        double sum = 0.0, notional = 0.0, volume = 0.0;
+        double lo = prices[first], hi = prices[first];
+        for (std::size_t j = first; j <= i; ++j) {
+            sum += prices[j];
+            notional += prices[j] * (1.0 + static_cast<double>(j % 7));
+            volume += 1.0 + static_cast<double>(j % 7);
+            lo = std::min(lo, prices[j]);
+            hi = std::max(hi, prices[j]);
+        }
+        double n = static_cast<double>(i + 1 - first);
+        double mean = sum / n;
+        double var = 0.0;
+        for (std::size_t j = first; j <= i; ++j) var += (prices[j] - mean) * (prices[j] - mean);
+        var /= n;
+
+        REQUIRE(stats.size() == i + 1 - first);
+        REQUIRE(stats.mean() == Catch::Approx(mean).epsilon(1e-9));
+        REQUIRE(stats.variance() == Catch::Approx(var).epsilon(1e-6).margin(1e-9));
+        REQUIRE(low.value() == lo);
+        REQUIRE(high.value() == hi);
+        REQUIRE(vwap.value() == Catch::Approx(notional / volume).epsilon(1e-9));
+        if (var > 0.0) {
+            REQUIRE(z.score(prices[i]) == Catch::Approx((prices[i] - mean) / std::sqrt(var)).epsilon(1e-6));
+        }
+    }
+}
+
+TEST_CASE("Ema seeds with the first value and converges to a constant input", "[indicators]") {
+    Ema ema = Ema::withPeriod(9);  // alpha 0.2
+    REQUIRE_FALSE(ema.seeded());
+    ema.add(10.0);
+    REQUIRE(ema.value() == 10.0);
+    ema.add(20.0);
+    REQUIRE(ema.value() == Catch::Approx(12.0));
+    for (int i = 0; i < 200; ++i) ema.add(5.0);
+    REQUIRE(ema.value() == Catch::Approx(5.0));
+
+    REQUIRE_THROWS_AS(Ema(0.0), std::invalid_argument);
+}
@@ -26,8 +26,8 @@ TEST_CASE("MarketMaker integration test with live engine", "integration") {
         mm.onTrade(t);
     });
 
-    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 1, 12300});
-    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 12300});
+    book.addOrder(Order{1001, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 1, 12300});
+    book.addOrder(Order{1002, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 12300});
     mm.start();
     std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // allow quotes to form
 
@@ -0,0 +1,124 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/journal.hpp"
+#include "engine/simulator.hpp"
+#include "strategy/momentum_trader.hpp"
+#include "core/order.hpp"
+#include "test_support.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+using namespace test_support;
+
+TEST_CASE("Journal records round-trip in sequence order", "[journal]") {
+    auto path = tempPath("tradeit_roundtrip.journal");
+    {
+        JournalWriter writer(path, 64);  // tiny batches force several writes
+        Order iceberg(7, "BTC-USD", OrderType::LIMIT, Side::SELL, 20'000.5, 10, 42);
+        iceberg.display_quantity = 2;
+        iceberg.owner_id = 3;
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(writer.append(JournalEvent::STRATEGY_ORDER, 1000 + i, iceberg) == static_cast<uint64_t>(i));
+        }
+        writer.append(JournalEvent::CANCEL, 2000, Order(7, "BTC-USD", OrderType::LIMIT, Side::BUY, 0.0, 0, 2000));
+        writer.flush();
+    }
+
+    JournalReader reader(path);
+    JournalRecord record;
+    for (uint64_t i = 0; i < 10; ++i) {
+        REQUIRE(reader.next(record));
+        REQUIRE(record.sequence == i);
+        REQUIRE(record.sim_time == 1000 + i);
+        REQUIRE(record.event == JournalEvent::STRATEGY_ORDER);
+        REQUIRE(record.order.instrument == "BTC-USD");
+        REQUIRE(record.order.price == 20'000.5);
+        REQUIRE(record.order.display_quantity == 2);
+        REQUIRE(record.order.owner_id == 3);
+        REQUIRE(record.order.side == Side::SELL);
+    }
+    REQUIRE(reader.next(record));
+    REQUIRE(record.event == JournalEvent::CANCEL);
+    REQUIRE_FALSE(reader.next(record));
+}
+
+TEST_CASE("Journal reader stops at a record cut short", "[journal]") {
+    auto path = tempPath("tradeit_torn.journal");
+    {
+        JournalWriter writer(path);
+        writer.append(JournalEvent::TICK, 1, Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1));
+        writer.append(JournalEvent::TICK, 2, Order(2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 2));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    JournalReader reader(path);
+    JournalRecord record;
+    REQUIRE(reader.next(record));
+    REQUIRE(record.order.id == 1);
+    REQUIRE_FALSE(reader.next(record));
+}
+
+TEST_CASE("Journal reader rejects files that are not journals", "[journal]") {
+    auto path = tempPath("tradeit_not_a.journal");
+    std::ofstream(path) << "timestamp,instrument,side,price,quantity\n";
+    REQUIRE_THROWS_AS(JournalReader(path), std::runtime_error);
+}
+
+TEST_CASE("Replaying a journal reproduces books and trades", "[journal]") {
+    auto path = tempPath("tradeit_replay.journal");
+    auto ticks = choppyTicks();
+
+    auto original_tape = std::make_shared<TradeTape>();
+    DepthSnapshot original_depth;
+    {
+        Simulator simulator;
+        simulator.setOrderEntryLatency(std::make_unique<FixedLatency>(300));
+        simulator.setJournal(std::make_shared<JournalWriter>(path));
+        auto trader = std::make_shared<MomentumTrader>("ETH-USD", simulator.makeSubmitter(1), -1e9);
+        trader->setLogDirectory("");
+        simulator.registerStrategy(trader);
+        simulator.registerStrategy(original_tape);
+
+        simulator.start();
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            simulator.onMarketData(ticks[i]);
+            if (i % 25 == 24) {
+                simulator.onCancel("ETH-USD", ticks[i - 3].id);
+            }
+        }
+        simulator.stop();
+        simulator.getBook("ETH-USD").depthSnapshot(10, original_depth);
+        REQUIRE(trader->totalTrades() > 0);
+    }   // the journal is flushed when the simulator lets go of it
+
+    auto replay_tape = std::make_shared<TradeTape>();
+    Simulator replayed;
+    replayed.registerStrategy(replay_tape);
+    JournalReader reader(path);
+    JournalRecord record;
+    while (reader.next(record)) {
+        replayed.replay(record);
+    }
+
+    REQUIRE(replay_tape->trades == original_tape->trades);
+
+    DepthSnapshot replay_depth;
+    replayed.getBook("ETH-USD").depthSnapshot(10, replay_depth);
+    REQUIRE(replay_depth.bids.size() == original_depth.bids.size());
+    REQUIRE(replay_depth.asks.size() == original_depth.asks.size());
+    for (std::size_t i = 0; i < original_depth.bids.size(); ++i) {
+        REQUIRE(replay_depth.bids[i].price == original_depth.bids[i].price);
+        REQUIRE(replay_depth.bids[i].quantity == original_depth.bids[i].quantity);
+    }
+    for (std::size_t i = 0; i < original_depth.asks.size(); ++i) {
+        REQUIRE(replay_depth.asks[i].price == original_depth.asks[i].price);
+        REQUIRE(replay_depth.asks[i].quantity == original_depth.asks[i].quantity);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include "strategy/market_maker.hpp"
 #include "engine/order_book.hpp"
+#include "engine/simulator.hpp"
 #include "core/trade.hpp"
 
 using namespace strategy;
@@ -89,4 +90,85 @@ TEST_CASE("MarketMaker logs quote activity", "marketmaker") {
     mm.stop();
 
     REQUIRE(submitted.size() >= 2); // should have submitted at least a bid and ask
-}
\ No newline at end of file
+}
+TEST_CASE("MarketMaker tracks tick flow imbalance and volatility over a fixed window", "marketmaker") {
+    OrderBook book("ETH-USD");
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 1, 1000});
+    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1001});
+    std::vector<Order> submitted;
+    MarketMaker mm("ETH-USD", book, [&](const Order& o) { submitted.push_back(o); }, -9999.0);
+
+    REQUIRE(mm.flowImbalance() == 0.0);
+    REQUIRE(mm.shortTermVolatility() == 0.0);
+
+    // 100 sells fill the window, then 100 buys push every sell out of it
+    for (uint64_t i = 0; i < 100; ++i) {
+        mm.onMarketData(Order{10 + i, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, i});
+    }
+    REQUIRE(mm.flowImbalance() == -1.0);
+    for (uint64_t i = 0; i < 50; ++i) {
+        mm.onMarketData(Order{200 + i, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 2, 100 + i});
+    }
+    REQUIRE(mm.flowImbalance() == 0.0);
+    for (uint64_t i = 0; i < 50; ++i) {
+        mm.onMarketData(Order{300 + i, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 2, 150 + i});
+    }
+    REQUIRE(mm.flowImbalance() == 1.0);
+    REQUIRE(mm.shortTermVolatility() == 0.0);  // flat prices; market ticks carry none
+
+    // all-buy flow leans both quotes above the symmetric 99/101
+    mm.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    mm.stop();
+    std::vector<Order> quotes;
+    for (const auto& o : submitted) {
+        if (o.quantity > 0) quotes.push_back(o);  // skip cancels
+    }
+    REQUIRE(quotes.size() >= 2);
+    REQUIRE(quotes[0].side == Side::BUY);
+    REQUIRE(quotes[0].price > 99.0);
+    REQUIRE(quotes[1].price > 101.0);
+
+    // choppy prices widen the quotes past the book spread
+    for (uint64_t i = 0; i < 100; ++i) {
+        mm.onMarketData(Order{400 + i, "ETH-USD", OrderType::LIMIT, i % 2 ? Side::BUY : Side::SELL,
+                              i % 2 ? 95.0 : 105.0, 2, 200 + i});
+    }
+    REQUIRE(mm.flowImbalance() == 0.0);
+    REQUIRE(mm.shortTermVolatility() > 0.05);
+}
+
+TEST_CASE("MarketMaker pulls stale ladder levels from the book on re-quote", "marketmaker") {
+    Simulator simulator;  // book fills: strategy quotes rest in the book
+    auto mm = std::make_shared<MarketMaker>("ETH-USD", simulator.getBook("ETH-USD"),
+                                            simulator.makeSubmitter(1), -9999.0);
+    mm->setQuotingModel(std::make_unique<AvellanedaStoikovQuoting>());
+    simulator.registerStrategy(mm, 1);
+    simulator.start();
+
+    auto owned = [&] {
+        std::size_t count = 0;
+        for (const auto& [id, order] : simulator.getBook("ETH-USD").getOrders()) {
+            if (order.owner_id == 1) ++count;
+        }
+        return count;
+    };
+
+    // the market drifts up every second; each quote timer finds the old ladder stale
+    for (uint64_t i = 0; i < 10; ++i) {
+        uint64_t ts = (i + 1) * 1'000'000;
+        double shift = 0.5 * static_cast<double>(i);
+        simulator.onMarketData(Order{1000 + 2 * i, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0 + shift, 1, ts});
+        simulator.onMarketData(Order{1001 + 2 * i, "ETH-USD", OrderType::LIMIT, Side::SELL, 110.0 + shift, 1, ts + 1});
+        REQUIRE(owned() <= 2 * QuoteSet::max_levels);
+    }
+    simulator.stop();
+
+    // the ladder was replaced several times, yet only the latest one rests
+    uint64_t newest = 0;
+    for (const auto& [id, order] : simulator.getBook("ETH-USD").getOrders()) {
+        if (order.owner_id == 1) newest = std::max(newest, id);
+    }
+    REQUIRE(newest > 4 * QuoteSet::max_levels);
+    REQUIRE(owned() > 0);
+}
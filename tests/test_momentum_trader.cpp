@@ -61,4 +61,48 @@ TEST_CASE("MomentumTrader avoids action if insufficient data", "[momentum]") {
     trader.stop();
 
     REQUIRE(submitted.empty());  // not enough data to act
-}
\ No newline at end of file
+}
+TEST_CASE("MomentumTrader evaluates on book events instead of a timer", "[momentum]") {
+    std::vector<Order> submitted;
+    MomentumTrader trader("ETH-USD",
+        [&](const Order& o) { submitted.push_back(o); },
+        -500.0);
+    trader.subscribeBookEvents();
+
+    trader.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1});
+    trader.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 1, 2});
+    trader.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 103.0, 1, 3});
+
+    trader.start();
+    REQUIRE(submitted.empty());
+
+    engine::BookEvent event;
+    event.instrument = "ETH-USD";
+    event.bbo_changed = true;
+    trader.onBookUpdate(event);
+    trader.stop();
+
+    REQUIRE(submitted.size() == 1);
+    REQUIRE(submitted[0].side == Side::BUY);
+}
+
+TEST_CASE("MomentumTrader acts on warm-up history without live ticks", "[momentum]") {
+    std::vector<Order> submitted;
+    MomentumTrader trader("ETH-USD",
+        [&](const Order& o) { submitted.push_back(o); },
+        -500.0);
+    trader.subscribeBookEvents();
+
+    std::vector<double> history{90.0, 95.0, 100.0, 101.0, 103.0, 99.0, 96.0};
+    trader.warmUp(history);
+    trader.start();
+
+    engine::BookEvent event;
+    event.instrument = "ETH-USD";
+    event.bbo_changed = true;
+    trader.onBookUpdate(event);
+    trader.stop();
+
+    REQUIRE(submitted.size() == 1);
+    REQUIRE(submitted[0].side == Side::SELL);  // 96 is below the last five prices' average
+}
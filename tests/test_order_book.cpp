@@ -6,6 +6,9 @@
 #include "core/order.hpp"
 #include "core/trade.hpp"
 
+#include <atomic>
+#include <thread>
+
 using namespace core;
 using namespace engine;
 
@@ -74,4 +77,394 @@ TEST_CASE("OrderBook - Market Order Match", "[orderbook]") {
     REQUIRE(trades.size() == 1);
     REQUIRE(trades[0].quantity == 2);
     REQUIRE(trades[0].price == Catch::Approx(200.0));
-}
\ No newline at end of file
+}
+
+TEST_CASE("OrderBook - Iceberg Shows Only Displayed Clip", "[orderbook]") {
+    OrderBook book("ETH-USD");
+
+    Order iceberg(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 10, 1000);
+    iceberg.display_quantity = 3;
+    book.addOrder(iceberg);
+
+    auto best_ask = book.getBestAsk();
+    REQUIRE(best_ask);
+    REQUIRE(best_ask->quantity == 3);
+    REQUIRE(book.getOrders().at(iceberg.id).quantity == 3);
+}
+
+TEST_CASE("OrderBook - Iceberg Replenishes At Back Of Level", "[orderbook]") {
+    OrderBook book("ETH-USD");
+
+    std::vector<Trade> trades;
+    book.setTradeCallback([&](const Trade& t) {
+        trades.push_back(t);
+    });
+
+    Order iceberg(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 5, 1000);
+    iceberg.display_quantity = 2;
+    book.addOrder(iceberg);
+    Order plain(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1001);
+    book.addOrder(plain);
+
+    // take the first clip: the next clip must queue behind the plain order
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 2, 1002));
+    REQUIRE(trades.size() == 1);
+    REQUIRE(trades[0].sell_order_id == iceberg.id);
+
+    auto best_ask = book.getBestAsk();
+    REQUIRE(best_ask);
+    REQUIRE(best_ask->id == plain.id);
+
+    // sweep the rest: plain order, then the remaining hidden quantity clip by clip
+    trades.clear();
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 10, 1003));
+
+    uint32_t iceberg_filled = 0;
+    for (const auto& t : trades) {
+        if (t.sell_order_id == iceberg.id) iceberg_filled += t.quantity;
+    }
+    REQUIRE(trades.front().sell_order_id == plain.id);
+    REQUIRE(iceberg_filled == 3);
+    REQUIRE_FALSE(book.getBestAsk());
+}
+
+TEST_CASE("OrderBook - Limit Order Respects Its Price And Rests Remainder", "[orderbook]") {
+    OrderBook book("ETH-USD");
+
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000));
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 105.0, 1, 1001));
+
+    auto trades = book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 3, 1002));
+
+    REQUIRE(trades.size() == 1);
+    REQUIRE(trades[0].price == Catch::Approx(100.0));
+
+    auto best_bid = book.getBestBid();
+    REQUIRE(best_bid);
+    REQUIRE(best_bid->price == Catch::Approx(101.0));
+    REQUIRE(best_bid->quantity == 2);
+
+    auto best_ask = book.getBestAsk();
+    REQUIRE(best_ask);
+    REQUIRE(best_ask->price == Catch::Approx(105.0));
+}
+
+TEST_CASE("OrderBook - Self-Trade Prevention Cancel Newest", "[orderbook]") {
+    OrderBook book("ETH-USD", SelfTradePrevention::CANCEL_NEWEST);
+
+    Order own_ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, 1000);
+    own_ask.owner_id = 7;
+    book.addOrder(own_ask);
+
+    Order own_bid(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1001);
+    own_bid.owner_id = 7;
+    auto trades = book.addOrder(own_bid);
+
+    REQUIRE(trades.empty());
+    REQUIRE_FALSE(book.getBestBid());      // incoming order was canceled, not rested
+    REQUIRE(book.getBestAsk()->quantity == 2);
+}
+
+TEST_CASE("OrderBook - Self-Trade Prevention Cancel Oldest Keeps Matching", "[orderbook]") {
+    OrderBook book("ETH-USD", SelfTradePrevention::CANCEL_OLDEST);
+
+    Order own_ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000);
+    own_ask.owner_id = 7;
+    book.addOrder(own_ask);
+    Order other_ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1001);
+    book.addOrder(other_ask);
+
+    Order own_bid(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 1, 1002);
+    own_bid.owner_id = 7;
+    auto trades = book.addOrder(own_bid);
+
+    REQUIRE(trades.size() == 1);
+    REQUIRE(trades[0].sell_order_id == other_ask.id);
+    REQUIRE(book.getOrders().count(own_ask.id) == 0);
+}
+
+TEST_CASE("OrderBook - Self-Trade Prevention Decrement", "[orderbook]") {
+    OrderBook book("ETH-USD", SelfTradePrevention::DECREMENT);
+
+    Order own_ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 5, 1000);
+    own_ask.owner_id = 7;
+    book.addOrder(own_ask);
+
+    Order own_bid(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 2, 1001);
+    own_bid.owner_id = 7;
+    auto trades = book.addOrder(own_bid);
+
+    REQUIRE(trades.empty());
+    REQUIRE_FALSE(book.getBestBid());
+    REQUIRE(book.getBestAsk()->quantity == 3);
+
+    // anonymous flow still trades with the owner's order
+    trades = book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 1, 1002));
+    REQUIRE(trades.size() == 1);
+}
+
+TEST_CASE("OrderBook - Pro-Rata Allocation", "[orderbook]") {
+    BasicOrderBook<ProRataMatching> book("ETH-USD");
+
+    Order a(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 10, 1000);
+    Order b(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 20, 1001);
+    Order c(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 31, 1002);
+    book.addOrder(a);
+    book.addOrder(b);
+    book.addOrder(c);
+
+    auto trades = book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 30, 1003));
+
+    std::unordered_map<uint64_t, uint32_t> filled;
+    for (const auto& t : trades) filled[t.sell_order_id] += t.quantity;
+
+    // floor(30 * size / 61) = 4, 9, 15; the 2 leftover lots go to the earliest order
+    REQUIRE(filled[a.id] == 6);
+    REQUIRE(filled[b.id] == 9);
+    REQUIRE(filled[c.id] == 15);
+    REQUIRE(book.getBestAsk()->id == a.id);
+}
+
+TEST_CASE("OrderBook - Pro-Rata With Top Order Priority", "[orderbook]") {
+    BasicOrderBook<ProRataTopOrderMatching> book("ETH-USD");
+
+    Order top(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 10, 1000);
+    Order b(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 20, 1001);
+    Order c(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 30, 1002);
+    book.addOrder(top);
+    book.addOrder(b);
+    book.addOrder(c);
+
+    auto trades = book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 20, 1003));
+
+    std::unordered_map<uint64_t, uint32_t> filled;
+    for (const auto& t : trades) filled[t.buy_order_id] += t.quantity;
+
+    REQUIRE(filled[top.id] == 10);
+    REQUIRE(filled[b.id] == 4);
+    REQUIRE(filled[c.id] == 6);
+    REQUIRE(book.getOrders().count(top.id) == 0);
+    REQUIRE(book.getOrders().at(c.id).quantity == 24);
+}
+
+TEST_CASE("OrderBook - Depth Snapshot Tracks Adds, Fills And Cancels", "[orderbook]") {
+    OrderBook book("ETH-USD");
+
+    Order a(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 3, 1000);
+    Order b(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 2, 1001);
+    book.addOrder(a);
+    book.addOrder(b);
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 98.0, 4, 1002));
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 97.0, 1, 1003));
+    Order iceberg(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 50, 1004);
+    iceberg.display_quantity = 5;
+    book.addOrder(iceberg);
+
+    DepthSnapshot depth;
+    book.depthSnapshot(2, depth);
+
+    REQUIRE(depth.bids.size() == 2);
+    REQUIRE(depth.bids[0].price == Catch::Approx(99.0));
+    REQUIRE(depth.bids[0].quantity == 5);
+    REQUIRE(depth.bids[0].order_count == 2);
+    REQUIRE(depth.bids[1].price == Catch::Approx(98.0));
+    REQUIRE(depth.asks.size() == 1);
+    REQUIRE(depth.asks[0].quantity == 5); // displayed clip only
+
+    // partial fill at 99, then cancel the other order there
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 1, 1005));
+    book.depthSnapshot(2, depth);
+    REQUIRE(depth.bids[0].quantity == 4);
+
+    REQUIRE(book.cancelOrder(b.id));
+    book.depthSnapshot(2, depth);
+    REQUIRE(depth.bids[0].quantity == 2);
+    REQUIRE(depth.bids[0].order_count == 1);
+
+    REQUIRE(book.cancelOrder(a.id));
+    book.depthSnapshot(2, depth);
+    REQUIRE(depth.bids[0].price == Catch::Approx(98.0));
+    REQUIRE(depth.bids[1].price == Catch::Approx(97.0));
+}
+
+TEST_CASE("OrderBook - Top Of Book Is Published On Change", "[orderbook]") {
+    OrderBook book("ETH-USD");
+
+    auto top = book.topOfBook();
+    REQUIRE_FALSE(top.hasBid());
+    REQUIRE_FALSE(top.hasAsk());
+
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 2, 1000));
+    Order ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 3, 1001);
+    book.addOrder(ask);
+
+    top = book.topOfBook();
+    REQUIRE(top.bid_price == Catch::Approx(99.0));
+    REQUIRE(top.bid_size == 2);
+    REQUIRE(top.ask_price == Catch::Approx(101.0));
+    REQUIRE(top.ask_size == 3);
+    uint64_t seq = top.sequence;
+
+    // a deeper order leaves the BBO, and its sequence, unchanged
+    book.addOrder(Order(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, 98.0, 1, 1002));
+    REQUIRE(book.topOfBook().sequence == seq);
+
+    book.cancelOrder(ask.id);
+    top = book.topOfBook();
+    REQUIRE(top.sequence > seq);
+    REQUIRE_FALSE(top.hasAsk());
+}
+
+TEST_CASE("OrderBook - Top Of Book Reads Are Consistent Under Concurrent Updates", "[orderbook]") {
+    OrderBook book("ETH-USD");
+    std::atomic<bool> done{false};
+    std::atomic<bool> crossed{false};
+
+    // the book never rests crossed, so a torn bid/ask pair would show up as bid >= ask
+    std::thread reader([&] {
+        while (!done) {
+            auto top = book.topOfBook();
+            if (top.hasBid() && top.hasAsk() && top.bid_price >= top.ask_price) crossed = true;
+        }
+    });
+
+    uint64_t prev_bid = 0, prev_ask = 0;
+    for (int i = 0; i < 500; ++i) {
+        double mid = 100.0 + (i % 20 < 10 ? i % 10 : 10 - i % 10);
+        Order bid(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::BUY, mid - 1.0, 1, i);
+        Order ask(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, Side::SELL, mid + 1.0, 1, i);
+        book.addOrder(bid);
+        book.addOrder(ask);
+        if (prev_bid) book.cancelOrder(prev_bid);
+        if (prev_ask) book.cancelOrder(prev_ask);
+        prev_bid = bid.id;
+        prev_ask = ask.id;
+    }
+
+    done = true;
+    reader.join();
+    REQUIRE_FALSE(crossed);
+}
+
+TEST_CASE("OrderBook - Auction Collects Orders And Uncrosses At Maximum Volume", "[orderbook][auction]") {
+    OrderBook book("ETH-USD");
+    book.startAuction();
+    REQUIRE(book.phase() == TradingPhase::AUCTION);
+
+    std::vector<Order> orders = {
+        Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 5, 1),
+        Order(2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 5, 2),
+        Order(3, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 3),
+        Order(4, "ETH-USD", OrderType::LIMIT, Side::SELL, 98.0, 4, 4),
+        Order(5, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 6, 5),
+        Order(6, "ETH-USD", OrderType::LIMIT, Side::SELL, 102.0, 5, 6),
+    };
+    for (const auto& order : orders) {
+        REQUIRE(book.addOrder(order).empty());
+    }
+
+    // demand/supply: 98 -> 15/4, 99 -> 15/4, 100 -> 10/10, 101 -> 5/10
+    auto quote = book.indicativeUncross();
+    REQUIRE(quote);
+    REQUIRE(quote->price == 100.0);
+    REQUIRE(quote->volume == 10);
+    REQUIRE(quote->imbalance == 0);
+
+    auto trades = book.uncross(10);
+    REQUIRE(book.phase() == TradingPhase::CONTINUOUS);
+    REQUIRE(trades.size() == 3);
+    uint32_t volume = 0;
+    for (const auto& t : trades) {
+        REQUIRE(t.price == 100.0);
+        volume += t.quantity;
+    }
+    REQUIRE(volume == 10);
+    REQUIRE(trades[0].buy_order_id == 1);
+    REQUIRE(trades[0].sell_order_id == 4);
+
+    auto top = book.topOfBook();
+    REQUIRE(top.bid_price == 99.0);
+    REQUIRE(top.bid_size == 5);
+    REQUIRE(top.ask_price == 102.0);
+    REQUIRE(top.ask_size == 5);
+
+    // back to continuous matching
+    REQUIRE(book.addOrder(Order(7, "ETH-USD", OrderType::LIMIT, Side::SELL, 99.0, 1, 11)).size() == 1);
+}
+
+TEST_CASE("OrderBook - Auction Tie-Breaks On Surplus, Pressure And Reference Price", "[orderbook][auction]") {
+    auto quote = [](uint32_t bid_qty, uint32_t ask_qty, std::optional<double> reference = std::nullopt) {
+        OrderBook book("ETH-USD");
+        book.startAuction();
+        book.addOrder(Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, bid_qty, 1));
+        book.addOrder(Order(2, "ETH-USD", OrderType::LIMIT, Side::SELL, 99.0, ask_qty, 2));
+        return book.indicativeUncross(reference);
+    };
+
+    // same volume and surplus at 99 and 101
+    REQUIRE(quote(10, 5)->price == 101.0);  // buy surplus everywhere: highest price
+    REQUIRE(quote(10, 5)->imbalance == 5);
+    REQUIRE(quote(5, 10)->price == 99.0);   // sell surplus everywhere: lowest price
+    REQUIRE(quote(5, 5, 100.8)->price == 101.0);
+    REQUIRE(quote(5, 5, 99.1)->price == 99.0);
+
+    OrderBook uncrossed("ETH-USD");
+    uncrossed.startAuction();
+    uncrossed.addOrder(Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1));
+    uncrossed.addOrder(Order(2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 5, 2));
+    REQUIRE_FALSE(uncrossed.indicativeUncross());
+    REQUIRE(uncrossed.uncross(3).empty());
+}
+
+TEST_CASE("OrderBook - Auction Fills Market Orders First And Counts Hidden Size", "[orderbook][auction]") {
+    OrderBook book("ETH-USD");
+    book.startAuction();
+
+    Order iceberg(1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 10, 1);
+    iceberg.display_quantity = 2;
+    book.addOrder(iceberg);
+    book.addOrder(Order(2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 4, 2));
+    book.addOrder(Order(3, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 3, 3));
+    book.addOrder(Order(4, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 9, 4));
+    REQUIRE(book.cancelOrder(4));  // waiting market orders can be cancelled
+
+    // 7 demanded against 10 offered, only 2 of them displayed
+    auto trades = book.uncross(5);
+    uint32_t volume = 0;
+    for (const auto& t : trades) volume += t.quantity;
+    REQUIRE(volume == 7);
+    REQUIRE(trades.front().buy_order_id == 3);
+    REQUIRE(trades.back().buy_order_id == 2);
+
+    REQUIRE_FALSE(book.getBestBid());
+    REQUIRE(book.getOrders().size() == 1);
+    REQUIRE(book.topOfBook().ask_size == 1);  // clip left after 7 of 10
+
+    // market orders the uncross cannot fill are dropped
+    OrderBook thin("ETH-USD");
+    thin.startAuction();
+    thin.addOrder(Order(5, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, 1));
+    thin.addOrder(Order(6, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 5, 2));
+    REQUIRE(thin.uncross(3).size() == 1);
+    REQUIRE(thin.getOrders().empty());
+    REQUIRE(thin.addOrder(Order(7, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 4)).empty());
+}
+
+TEST_CASE("OrderBook - Auction Ignores Zero-Quantity Resubmits", "[orderbook][auction]") {
+    OrderBook book("ETH-USD");
+    book.startAuction();
+    book.addOrder(Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 5, 1));
+    book.addOrder(Order(2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 5, 2));
+
+    REQUIRE(book.addOrder(Order(1, "ETH-USD", OrderType::LIMIT, Side::BUY, 0.0, 0, 3)).empty());
+    book.addOrder(Order(3, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 0, 4));
+
+    REQUIRE(book.getOrders().at(1).quantity == 5);
+    REQUIRE(book.levelQuantity(Side::BUY, 0.0) == 0);
+    REQUIRE(book.topOfBook().bid_price == 100.0);
+
+    auto trades = book.uncross(5);
+    REQUIRE(trades.size() == 1);
+    REQUIRE(trades[0].buy_order_id == 1);
+    REQUIRE(trades[0].quantity == 5);
+}
@@ -0,0 +1,157 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "engine/position_keeper.hpp"
+#include "engine/simulator.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace core;
+using namespace engine;
+
+namespace {
+
+Trade fill(uint32_t buyer, uint32_t seller, uint32_t qty, double price, const std::string& instrument = "ETH-USD") {
+    Trade trade(1, 10, 11, instrument, price, qty, 0, Side::BUY);
+    trade.buy_owner_id = buyer;
+    trade.sell_owner_id = seller;
+    return trade;
+}
+
+}
+
+TEST_CASE("PositionKeeper keeps average cost and realizes on reduction and flips", "[positions]") {
+    PositionKeeper keeper;
+    keeper.addInstrument("ETH-USD");
+    keeper.addInstrument("BTC-USD");
+    keeper.addAccount(1);
+    keeper.addAccount(2);
+
+    keeper.onFill(fill(1, 2, 10, 100.0));
+    keeper.onFill(fill(1, 0, 10, 110.0));
+    Position pos = keeper.position(1, "ETH-USD");
+    REQUIRE(pos.quantity == 20);
+    REQUIRE(pos.average_cost == Catch::Approx(105.0));
+    REQUIRE(pos.unrealized_pnl == Catch::Approx(20 * (110.0 - 105.0)));  // marked at the last fill
+    REQUIRE(keeper.position(2, "ETH-USD").quantity == -10);
+
+    // sell 25 at 120: 20 close for +300, 5 open short at 120
+    keeper.onFill(fill(0, 1, 25, 120.0));
+    pos = keeper.position(1, "ETH-USD");
+    REQUIRE(pos.quantity == -5);
+    REQUIRE(pos.average_cost == Catch::Approx(120.0));
+    REQUIRE(pos.realized_pnl == Catch::Approx(300.0));
+    REQUIRE(pos.unrealized_pnl == Catch::Approx(0.0));
+    REQUIRE(pos.fills == 3);
+    REQUIRE(pos.filled_quantity == 45);
+
+    // the counterparty short from 100 is marked at 120
+    REQUIRE(keeper.position(2, "ETH-USD").unrealized_pnl == Catch::Approx(0.0));
+    keeper.onFill(fill(0, 2, 1, 120.0));
+    REQUIRE(keeper.position(2, "ETH-USD").unrealized_pnl == Catch::Approx(-11 * (120.0 - (10 * 100.0 + 120.0) / 11)));
+
+    // buy back 5 at 115 flattens the position
+    keeper.onFill(fill(1, 0, 5, 115.0));
+    pos = keeper.position(1, "ETH-USD");
+    REQUIRE(pos.quantity == 0);
+    REQUIRE(pos.average_cost == 0.0);
+    REQUIRE(pos.realized_pnl == Catch::Approx(325.0));
+
+    AccountPnL totals = keeper.pnl(1);
+    REQUIRE(totals.realized_pnl == Catch::Approx(325.0));
+    REQUIRE(totals.unrealized_pnl == Catch::Approx(0.0));
+    REQUIRE(totals.fills == 4);
+
+    REQUIRE(keeper.position(3, "ETH-USD").quantity == 0);
+    REQUIRE(keeper.position(1, "SOL-USD").quantity == 0);
+    REQUIRE(keeper.pnl(3).fills == 0);
+    REQUIRE_THROWS_AS(keeper.addInstrument("SOL-USD"), std::logic_error);
+    REQUIRE_THROWS_AS(keeper.addAccount(1), std::invalid_argument);
+}
+
+TEST_CASE("PositionKeeper marks to the book mid and tracks drawdown", "[positions]") {
+    OrderBook book("ETH-USD");
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1});
+    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 5, 2});
+
+    PositionKeeper keeper;
+    keeper.addInstrument("ETH-USD", &book);
+    keeper.addAccount(1);
+
+    keeper.onFill(fill(1, 0, 10, 100.0));
+    REQUIRE(keeper.position(1, "ETH-USD").mark_price == Catch::Approx(100.0));
+
+    book.addOrder(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 103.0, 8, 3});
+    book.addOrder(Order{4, "ETH-USD", OrderType::LIMIT, Side::SELL, 104.0, 5, 4});
+    // 103 crossed the 101 ask, so the mid is (103 + 104) / 2
+    keeper.mark("ETH-USD");
+    REQUIRE(keeper.pnl(1).unrealized_pnl == Catch::Approx(35.0));
+    REQUIRE(keeper.pnl(1).peak_pnl == Catch::Approx(35.0));
+
+    book.cancelOrder(3);
+    book.cancelOrder(1);
+    book.addOrder(Order{5, "ETH-USD", OrderType::LIMIT, Side::BUY, 95.0, 5, 5});
+    keeper.mark("ETH-USD");  // mid 99.5
+    AccountPnL totals = keeper.pnl(1);
+    REQUIRE(totals.unrealized_pnl == Catch::Approx(-5.0));
+    REQUIRE(totals.max_drawdown == Catch::Approx(40.0));
+
+    book.cancelOrder(5);
+    keeper.mark("ETH-USD");  // one-sided book keeps the last mark
+    REQUIRE(keeper.position(1, "ETH-USD").mark_price == Catch::Approx(99.5));
+}
+
+TEST_CASE("Simulator attributes fills to owners in its position keeper", "[positions][simulator]") {
+    Simulator simulator;
+    auto keeper = std::make_shared<PositionKeeper>();
+    keeper->addInstrument("ETH-USD", &simulator.getBook("ETH-USD"));
+    keeper->addAccount(1);
+    keeper->addAccount(2);
+    simulator.setPositionKeeper(keeper);
+
+    auto first = simulator.makeSubmitter(1);
+    auto second = simulator.makeSubmitter(2);
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 10, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 10, 1001});
+
+    first(Order{50, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 4, 1002});
+    second(Order{60, "ETH-USD", OrderType::LIMIT, Side::SELL, 99.0, 3, 1003});
+    REQUIRE(keeper->position(1, "ETH-USD").quantity == 4);
+    REQUIRE(keeper->position(2, "ETH-USD").quantity == -3);
+
+    // a tick that lifts the best bid re-marks both accounts
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 2000});
+    REQUIRE(keeper->position(1, "ETH-USD").mark_price == Catch::Approx(100.5));
+    REQUIRE(keeper->pnl(1).unrealized_pnl == Catch::Approx(4 * (100.5 - 101.0)));
+    REQUIRE(keeper->pnl(2).unrealized_pnl == Catch::Approx(-3 * (100.5 - 99.0)));
+}
+
+TEST_CASE("PositionKeeper readers never see a torn position", "[positions]") {
+    PositionKeeper keeper;
+    keeper.addInstrument("ETH-USD");
+    keeper.addAccount(1);
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            Position pos = keeper.position(1, "ETH-USD");
+            // every fill buys one unit at 100, so the fields must agree
+            if (pos.quantity != static_cast<int64_t>(pos.fills) ||
+                (pos.fills > 0 && pos.average_cost != 100.0)) {
+                torn = true;
+            }
+        }
+    });
+
+    for (int i = 0; i < 200'000; ++i) {
+        keeper.onFill(fill(1, 0, 1, 100.0));
+    }
+    done = true;
+    reader.join();
+
+    REQUIRE_FALSE(torn.load());
+    REQUIRE(keeper.position(1, "ETH-USD").quantity == 200'000);
+}
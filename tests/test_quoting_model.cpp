@@ -0,0 +1,133 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "strategy/quoting_model.hpp"
+#include "strategy/market_maker.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace strategy;
+using namespace core;
+
+namespace {
+
+MarketState calmMarket() {
+    MarketState state;
+    state.mid = 100.0;
+    state.book_half_spread = 0.5;
+    state.inventory_limit = 10;
+    state.tick_volatility = 0.001;  // 0.1 per tick in price
+    state.tick_rate = 10.0;
+    state.trade_depth = 0.4;
+    return state;
+}
+
+}
+
+TEST_CASE("Avellaneda-Stoikov quotes shift away from the inventory side", "[quoting]") {
+    AvellanedaStoikovQuoting model;
+    MarketState flat = calmMarket();
+    QuoteSet quotes;
+    model.quote(flat, quotes);
+
+    REQUIRE(quotes.bid_levels == 3);
+    REQUIRE(quotes.ask_levels == 3);
+    double center = (quotes.bids[0].price + quotes.asks[0].price) / 2.0;
+    REQUIRE(center == Catch::Approx(100.0));
+
+    // gamma = 0.1, sigma^2 = 0.1^2 * 10 per second, T = 1
+    double risk = 0.1 * 0.01 * 10.0;
+    double half = (risk + 20.0 * std::log1p(0.1 * 0.4)) / 2.0;
+    REQUIRE(quotes.asks[0].price - quotes.bids[0].price == Catch::Approx(2.0 * half));
+    REQUIRE(quotes.bids[0].price - quotes.bids[1].price == Catch::Approx(0.5 * half));
+    REQUIRE(quotes.asks[2].price - quotes.asks[1].price == Catch::Approx(0.5 * half));
+
+    MarketState long_position = flat;
+    long_position.inventory = 4;
+    QuoteSet skewed;
+    model.quote(long_position, skewed);
+    REQUIRE(skewed.bids[0].price == Catch::Approx(quotes.bids[0].price - 4 * risk));
+    REQUIRE(skewed.asks[0].price == Catch::Approx(quotes.asks[0].price - 4 * risk));
+
+    MarketState volatile_market = flat;
+    volatile_market.tick_volatility = 0.01;
+    QuoteSet wide;
+    model.quote(volatile_market, wide);
+    REQUIRE(wide.asks[0].price - wide.bids[0].price > quotes.asks[0].price - quotes.bids[0].price);
+}
+
+TEST_CASE("Avellaneda-Stoikov ladders stop at the inventory limit", "[quoting]") {
+    AvellanedaStoikovQuoting::Params params;
+    params.levels = 4;
+    params.level_size = 2;
+    AvellanedaStoikovQuoting model(params);
+
+    MarketState state = calmMarket();
+    state.inventory = 7;  // 3 more may be bought, 17 sold
+    QuoteSet quotes;
+    model.quote(state, quotes);
+
+    REQUIRE(quotes.bid_levels == 2);
+    REQUIRE(quotes.bids[0].quantity == 2);
+    REQUIRE(quotes.bids[1].quantity == 1);
+    REQUIRE(quotes.ask_levels == 4);
+
+    state.inventory = 10;
+    model.quote(state, quotes);
+    REQUIRE(quotes.bid_levels == 0);
+
+    params.levels = QuoteSet::max_levels + 1;
+    REQUIRE_THROWS_AS(AvellanedaStoikovQuoting(params), std::invalid_argument);
+    params.levels = 1;
+    params.risk_aversion = 0.0;
+    REQUIRE_THROWS_AS(AvellanedaStoikovQuoting(params), std::invalid_argument);
+}
+
+TEST_CASE("Quote sets are computed in well under a microsecond", "[quoting][.benchmark]") {
+    AvellanedaStoikovQuoting model;
+    MarketState state = calmMarket();
+    QuoteSet quotes;
+    double checksum = 0.0;
+
+    const int runs = 100'000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        state.inventory = i % 11 - 5;
+        model.quote(state, quotes);
+        checksum += quotes.bids[0].price;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    REQUIRE(checksum > 0.0);
+    REQUIRE(std::chrono::duration<double, std::micro>(elapsed).count() / runs < 1.0);
+}
+
+TEST_CASE("MarketMaker places a layered ladder from its quoting model", "[quoting]") {
+    engine::OrderBook book("ETH-USD");
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 1, 1000});
+    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1001});
+
+    std::vector<Order> submitted;
+    MarketMaker mm("ETH-USD", book, [&](const Order& o) { submitted.push_back(o); }, -9999.0);
+    mm.setQuotingModel(std::make_unique<AvellanedaStoikovQuoting>());
+    mm.setLogDirectory("");
+
+    mm.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    mm.stop();
+
+    std::vector<double> bids, asks;
+    for (const auto& o : submitted) {
+        (o.side == Side::BUY ? bids : asks).push_back(o.price);
+    }
+    REQUIRE(bids.size() == 3);
+    REQUIRE(asks.size() == 3);
+    REQUIRE(bids[0] > bids[1]);
+    REQUIRE(asks[0] < asks[1]);
+    REQUIRE(bids[0] < 100.0);
+    REQUIRE(asks[0] > 100.0);
+}
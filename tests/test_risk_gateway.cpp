@@ -0,0 +1,184 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/risk_gateway.hpp"
+#include "engine/simulator.hpp"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+
+namespace {
+
+Order limitOrder(uint32_t owner, Side side, double price, uint32_t qty, const std::string& instrument = "ETH-USD") {
+    Order order(1, instrument, OrderType::LIMIT, side, price, qty, 0);
+    order.owner_id = owner;
+    return order;
+}
+
+Trade fill(uint32_t buyer, uint32_t seller, uint32_t qty, double price = 100.0) {
+    Trade trade(1, 10, 11, "ETH-USD", price, qty, 0, Side::BUY);
+    trade.buy_owner_id = buyer;
+    trade.sell_owner_id = seller;
+    return trade;
+}
+
+class RejectRecorder : public strategy::Strategy {
+public:
+    std::vector<std::pair<Order, RejectReason>> rejects;
+
+    void start() override {}
+    void stop() override {}
+    void onMarketData(const Order&) override {}
+    void onTrade(const Trade&) override {}
+    void onOrderRejected(const Order& order, RejectReason reason) override { rejects.emplace_back(order, reason); }
+    std::string name() const override { return "RejectRecorder"; }
+    void printSummary() const override {}
+    void exportSummary(const std::string&) const override {}
+};
+
+}
+
+TEST_CASE("RiskGateway enforces size, collar, position and notional limits", "[risk]") {
+    OrderBook book("ETH-USD");
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1});
+    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 5, 2});
+
+    RiskGateway gateway;
+    gateway.addInstrument("ETH-USD", &book);
+    RiskLimits limits;
+    limits.max_order_quantity = 10;
+    limits.price_collar = 0.05;
+    limits.max_position = 15;
+    limits.max_notional = 1250.0;
+    gateway.addAccount(1, limits);
+
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 10), 0) == RejectReason::NONE);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 11), 0) == RejectReason::ORDER_SIZE);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 106.0, 1), 0) == RejectReason::PRICE_COLLAR);
+    REQUIRE(gateway.check(limitOrder(1, Side::SELL, 94.0, 1), 0) == RejectReason::PRICE_COLLAR);
+
+    // long 10 after fills: 6 more breaks the position limit, 3 more at 101 the notional one
+    gateway.onFill(fill(1, 0, 10));
+    REQUIRE(gateway.position(1, "ETH-USD") == 10);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 6), 0) == RejectReason::POSITION_LIMIT);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 101.0, 2), 0) == RejectReason::NONE);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 101.0, 3), 0) == RejectReason::NOTIONAL_LIMIT);
+    Order market(2, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 2, 0);
+    market.owner_id = 1;
+    REQUIRE(gateway.check(market, 0) == RejectReason::NONE);  // valued at the 101 ask
+    REQUIRE(gateway.check(limitOrder(1, Side::SELL, 100.0, 10), 0) == RejectReason::NONE);  // reduces risk
+
+    REQUIRE(gateway.check(limitOrder(2, Side::BUY, 100.0, 1), 0) == RejectReason::UNKNOWN_ACCOUNT);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1, "SOL-USD"), 0) == RejectReason::UNKNOWN_INSTRUMENT);
+    REQUIRE(gateway.rejectedCount(1) == 6);
+
+    REQUIRE_THROWS_AS(gateway.addInstrument("BTC-USD"), std::logic_error);
+    REQUIRE_THROWS_AS(gateway.addAccount(1, limits), std::invalid_argument);
+}
+
+TEST_CASE("RiskGateway values market orders against a one-sided or empty book", "[risk]") {
+    OrderBook book("ETH-USD");
+    RiskGateway gateway;
+    gateway.addInstrument("ETH-USD", &book);
+    RiskLimits limits;
+    limits.max_notional = 1000.0;
+    gateway.addAccount(1, limits);
+
+    Order buy(1, "ETH-USD", OrderType::MARKET, Side::BUY, 0.0, 20, 0);
+    buy.owner_id = 1;
+    REQUIRE(gateway.check(buy, 0) == RejectReason::NOTIONAL_LIMIT);  // nothing to value it at
+
+    // no ask: the bid side prices it, 20 x 99 is over the limit, 10 x 99 is not
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1});
+    REQUIRE(gateway.check(buy, 0) == RejectReason::NOTIONAL_LIMIT);
+    buy.quantity = 10;
+    REQUIRE(gateway.check(buy, 0) == RejectReason::NONE);
+
+    Order sell(2, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 10, 0);
+    sell.owner_id = 1;
+    REQUIRE(gateway.check(sell, 0) == RejectReason::NONE);
+    sell.quantity = 11;
+    REQUIRE(gateway.check(sell, 0) == RejectReason::NOTIONAL_LIMIT);
+}
+
+TEST_CASE("RiskGateway throttles per second and halts on the kill switch", "[risk]") {
+    RiskGateway gateway;
+    gateway.addInstrument("ETH-USD");
+    RiskLimits limits;
+    limits.max_orders_per_second = 3;
+    gateway.addAccount(1, limits);
+    gateway.addAccount(2, RiskLimits{});
+
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1), 5'000'000) == RejectReason::NONE);
+    }
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1), 5'900'000) == RejectReason::RATE_LIMIT);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 0), 5'900'000) == RejectReason::NONE);  // cancel
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1), 6'000'000) == RejectReason::NONE);
+
+    gateway.kill(1);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1), 7'000'000) == RejectReason::KILL_SWITCH);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 0), 7'000'000) == RejectReason::NONE);
+    REQUIRE(gateway.check(limitOrder(2, Side::BUY, 100.0, 1), 7'000'000) == RejectReason::NONE);
+    gateway.kill();
+    REQUIRE(gateway.check(limitOrder(2, Side::BUY, 100.0, 1), 7'000'000) == RejectReason::KILL_SWITCH);
+    gateway.resume();
+    gateway.resume(1);
+    REQUIRE(gateway.check(limitOrder(1, Side::BUY, 100.0, 1), 7'000'000) == RejectReason::NONE);
+}
+
+TEST_CASE("Simulator reports risk rejects to the owning strategy and tracks fills", "[risk][simulator]") {
+    Simulator simulator;
+    auto gateway = std::make_shared<RiskGateway>();
+    gateway->addInstrument("ETH-USD", &simulator.getBook("ETH-USD"));
+    RiskLimits limits;
+    limits.max_order_quantity = 5;
+    gateway->addAccount(7, limits);
+    simulator.setRiskGateway(gateway);
+
+    auto recorder = std::make_shared<RejectRecorder>();
+    simulator.registerStrategy(recorder, 7);
+    auto submit = simulator.makeSubmitter(7);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 10, 1000});
+    submit(Order{50, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 8, 1001});
+    submit(Order{51, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 4, 1002});
+
+    // the reject waits for the next delivery point; the accepted order filled
+    REQUIRE(recorder->rejects.empty());
+    REQUIRE(gateway->position(7, "ETH-USD") == 4);
+    REQUIRE(simulator.getBook("ETH-USD").topOfBook().ask_size == 6);
+
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0, 1, 2000});
+    REQUIRE(recorder->rejects.size() == 1);
+    REQUIRE(recorder->rejects[0].first.id == 50);
+    REQUIRE(recorder->rejects[0].second == RejectReason::ORDER_SIZE);
+}
+
+TEST_CASE("RiskGateway checks cost well under a microsecond", "[risk][.benchmark]") {
+    OrderBook book("ETH-USD");
+    book.addOrder(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 5, 1});
+    book.addOrder(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 5, 2});
+    RiskGateway gateway;
+    gateway.addInstrument("ETH-USD", &book);
+    gateway.addInstrument("BTC-USD");
+    RiskLimits limits{10, 0.05, 100, 1e6, 0};
+    gateway.addAccount(1, limits);
+
+    Order order = limitOrder(1, Side::BUY, 100.0, 1);
+    const int runs = 1'000'000;
+    int accepted = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        order.quantity = 1 + i % 10;
+        accepted += gateway.check(order, i) == RejectReason::NONE;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    REQUIRE(accepted == runs);
+    REQUIRE(std::chrono::duration<double, std::nano>(elapsed).count() / runs < 1000.0);
+}
@@ -0,0 +1,309 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/simulator.hpp"
+#include "engine/latency_model.hpp"
+#include "strategy/strategy.hpp"
+#include "core/order.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+
+namespace {
+
+// Records what the simulator delivers and when, on the simulated clock.
+class RecordingStrategy : public Strategy {
+public:
+    std::vector<std::pair<uint64_t, uint64_t>> ticks;   // (order id, arrival time)
+    std::vector<std::pair<uint64_t, uint64_t>> fills;   // (trade id, arrival time)
+    std::vector<BookEvent> events;
+
+    void start() override {}
+    void stop() override {}
+    void onMarketData(const Order& order) override { ticks.push_back({order.id, clock().now()}); }
+    void onTrade(const Trade& trade) override { fills.push_back({trade.trade_id, clock().now()}); }
+    void onBookUpdate(const BookEvent& event) override { events.push_back(event); }
+    std::string name() const override { return "Recording"; }
+    void printSummary() const override {}
+    void exportSummary(const std::string&) const override {}
+};
+
+
+// Answers its first book event with a burst of bids that each move the BBO.
+class BurstStrategy : public RecordingStrategy {
+public:
+    SubmitOrderCallback submit;
+
+    void onBookUpdate(const BookEvent& event) override {
+        RecordingStrategy::onBookUpdate(event);
+        if (events.size() > 1) return;
+        for (uint64_t i = 0; i < 3; ++i) {
+            submit(Order{100 + i, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0 + static_cast<double>(i), 1, 0});
+        }
+    }
+};
+
+}
+
+TEST_CASE("Order entry latency delays strategy orders in simulated time", "[simulator][latency]") {
+    Simulator simulator;
+    simulator.setOrderEntryLatency(std::make_unique<FixedLatency>(300));
+    auto submit = simulator.makeSubmitter(1);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+    submit(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1000});
+
+    // still in flight
+    REQUIRE(simulator.getBook("ETH-USD").getOrders().count(1) == 1);
+
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::SELL, 105.0, 1, 1299});
+    REQUIRE(simulator.getBook("ETH-USD").getOrders().count(1) == 1);
+
+    simulator.onMarketData(Order{4, "ETH-USD", OrderType::LIMIT, Side::SELL, 105.0, 1, 1300});
+    REQUIRE(simulator.getBook("ETH-USD").getOrders().count(1) == 0);
+}
+
+TEST_CASE("Market data latency delays ticks and fills to strategies", "[simulator][latency]") {
+    Simulator simulator;
+    simulator.setMarketDataLatency(std::make_unique<FixedLatency>(50));
+    auto recorder = std::make_shared<RecordingStrategy>();
+    simulator.registerStrategy(recorder);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1020});
+    REQUIRE(recorder->ticks.empty());
+
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0, 1, 2000});
+    REQUIRE(recorder->ticks == std::vector<std::pair<uint64_t, uint64_t>>{{1, 1050}, {2, 1070}});
+    REQUIRE(recorder->fills.size() == 1);
+    REQUIRE(recorder->fills[0].second == 1070);
+}
+
+TEST_CASE("Sampled latency never reorders a channel", "[simulator][latency]") {
+    Simulator simulator;
+    simulator.setMarketDataLatency(std::make_unique<LogNormalLatency>(100.0, 1.5, 10, 7));
+    auto recorder = std::make_shared<RecordingStrategy>();
+    simulator.registerStrategy(recorder);
+
+    for (uint64_t i = 1; i <= 200; ++i) {
+        simulator.onMarketData(Order{i, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0, 1, 1000 + i * 5});
+    }
+    simulator.onMarketData(Order{999, "ETH-USD", OrderType::LIMIT, Side::BUY, 90.0, 1, 1'000'000});
+
+    REQUIRE(recorder->ticks.size() == 200);
+    for (size_t i = 1; i < recorder->ticks.size(); ++i) {
+        REQUIRE(recorder->ticks[i].first == recorder->ticks[i - 1].first + 1);
+        REQUIRE(recorder->ticks[i].second >= recorder->ticks[i - 1].second);
+    }
+}
+
+TEST_CASE("PerInstrumentLatency uses the fallback for unknown instruments", "[latency]") {
+    PerInstrumentLatency model(std::make_unique<FixedLatency>(10));
+    model.set("BTC-USD", std::make_unique<FixedLatency>(250));
+
+    REQUIRE(model.sample("BTC-USD") == 250);
+    REQUIRE(model.sample("ETH-USD") == 10);
+}
+
+TEST_CASE("Queue fills wait for the displayed quantity ahead", "[simulator][queue]") {
+    Simulator simulator;
+    simulator.setQueuePositionFills(true);
+    auto recorder = std::make_shared<RecordingStrategy>();
+    simulator.registerStrategy(recorder);
+    auto submit = simulator.makeSubmitter(1);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 5, 1000});
+    submit(Order{10, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 2, 1000});
+
+    // the strategy order is tracked by the model, not rested in the book
+    REQUIRE(simulator.getBook("ETH-USD").getOrders().count(10) == 0);
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 5);
+
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 4, 1100});
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 1);
+    REQUIRE(recorder->fills.size() == 1); // the historical print only
+
+    // one more unit clears the queue, the resting remainder then trades with us
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 3, 1200});
+    REQUIRE(simulator.queueFillModel().size() == 0);
+    REQUIRE(recorder->fills.size() == 3);
+    REQUIRE(simulator.getBook("ETH-USD").getOrders().at(3).quantity == 2);
+
+    // shadow fills never reuse a book trade ID
+    REQUIRE(recorder->fills[1].first < QueueFillModel::fill_id_base);
+    REQUIRE(recorder->fills[2].first >= QueueFillModel::fill_id_base);
+}
+
+TEST_CASE("Queue fills fill orders priced through a historical trade", "[simulator][queue]") {
+    Simulator simulator;
+    simulator.setQueuePositionFills(true);
+    std::vector<Trade> fills;
+    auto submit = simulator.makeSubmitter(1);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 5, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 102.0, 5, 1000});
+    submit(Order{10, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 2, 1000});
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 0);
+
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 1, 1100});
+    simulator.onMarketData(Order{4, "ETH-USD", OrderType::MARKET, Side::SELL, 0.0, 3, 1200});
+
+    REQUIRE(simulator.queueFillModel().size() == 0);
+    REQUIRE(simulator.getBook("ETH-USD").levelQuantity(Side::BUY, 100.0) == 1);
+}
+
+TEST_CASE("Queue fills advance on cancels of orders ahead only", "[simulator][queue]") {
+    Simulator simulator;
+    simulator.setQueuePositionFills(true);
+    auto submit = simulator.makeSubmitter(1);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 4, 1000});
+    submit(Order{10, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 3, 1100});
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 4);
+
+    simulator.onCancel("ETH-USD", 2);
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 4);
+
+    simulator.onCancel("ETH-USD", 1);
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 0);
+
+    // resubmitting the ID with zero quantity cancels the strategy order
+    submit(Order{10, "ETH-USD", OrderType::LIMIT, Side::SELL, 0.0, 0, 0});
+    REQUIRE(simulator.queueFillModel().size() == 0);
+}
+
+TEST_CASE("Queue fills let crossing strategy orders take liquidity first", "[simulator][queue]") {
+    Simulator simulator;
+    simulator.setQueuePositionFills(true);
+    auto submit = simulator.makeSubmitter(1);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, 1000});
+    submit(Order{10, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 5, 1000});
+
+    const auto& book = simulator.getBook("ETH-USD");
+    REQUIRE(book.getOrders().empty());
+    REQUIRE(simulator.queueFillModel().queueAhead(10) == 0);
+}
+
+TEST_CASE("Book events report BBO changes and trade prints", "[simulator][events]") {
+    Simulator simulator;
+    auto recorder = std::make_shared<RecordingStrategy>();
+    recorder->subscribeBookEvents(false);
+    simulator.registerStrategy(recorder);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 2, 1000});
+    REQUIRE(recorder->events.size() == 1);
+    REQUIRE(recorder->events[0].bbo_changed);
+    REQUIRE(recorder->events[0].top.ask_price == 100.0);
+    REQUIRE(recorder->events[0].traded_quantity == 0);
+
+    // deeper level: best bid/offer unchanged, nothing to report
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1100});
+    REQUIRE(recorder->events.size() == 1);
+
+    simulator.onMarketData(Order{3, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1200});
+    REQUIRE(recorder->events.size() == 2);
+    REQUIRE(recorder->events[1].traded_quantity == 1);
+    REQUIRE(recorder->events[1].last_trade_price == 100.0);
+    REQUIRE(recorder->events[1].top.ask_size == 1);
+    REQUIRE(recorder->events[1].timestamp == 1200);
+}
+
+TEST_CASE("Book events raised by a strategy's own orders are coalesced, not nested", "[simulator][events]") {
+    Simulator simulator;
+    auto burst = std::make_shared<BurstStrategy>();
+    burst->submit = simulator.makeSubmitter(1);
+    burst->subscribeBookEvents();
+    auto recorder = std::make_shared<RecordingStrategy>();
+    recorder->subscribeBookEvents(false);
+    simulator.registerStrategy(burst);
+    simulator.registerStrategy(recorder);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+
+    // the tick, then one merged event for the three bids
+    REQUIRE(burst->events.size() == 2);
+    REQUIRE(burst->events[1].top.bid_price == 92.0);
+    REQUIRE(burst->events[1].bbo_changed);
+
+    REQUIRE(recorder->events.size() == 4);
+    REQUIRE(recorder->events[1].top.bid_price == 90.0);
+    REQUIRE(recorder->events[3].top.bid_price == 92.0);
+}
+
+TEST_CASE("Strategies without a subscription get no book events", "[simulator][events]") {
+    Simulator simulator;
+    auto recorder = std::make_shared<RecordingStrategy>();
+    simulator.registerStrategy(recorder);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+
+    REQUIRE(recorder->ticks.size() == 1);
+    REQUIRE(recorder->events.empty());
+}
+
+TEST_CASE("Instrument subscriptions limit which strategies see an event", "[simulator][dispatch]") {
+    Simulator simulator;
+    auto eth = std::make_shared<RecordingStrategy>();
+    eth->subscribe("ETH-USD");
+    auto btc_trades = std::make_shared<RecordingStrategy>();
+    btc_trades->subscribe("BTC-USD", TRADES);
+    auto everything = std::make_shared<RecordingStrategy>();
+    simulator.registerStrategy(eth);
+    simulator.registerStrategy(btc_trades);
+    simulator.registerStrategy(everything);
+
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0, 1, 1100});
+    simulator.onMarketData(Order{3, "BTC-USD", OrderType::LIMIT, Side::SELL, 200.0, 1, 1200});
+    simulator.onMarketData(Order{4, "BTC-USD", OrderType::LIMIT, Side::BUY, 200.0, 1, 1300});
+    simulator.onMarketData(Order{5, "SOL-USD", OrderType::LIMIT, Side::BUY, 10.0, 1, 1400});
+
+    REQUIRE(eth->ticks.size() == 2);
+    REQUIRE(eth->fills.size() == 1);
+
+    REQUIRE(btc_trades->ticks.empty());
+    REQUIRE(btc_trades->fills.size() == 1);
+
+    REQUIRE(everything->ticks.size() == 5);
+    REQUIRE(everything->fills.size() == 2);
+}
+
+TEST_CASE("Book events follow instrument subscriptions", "[simulator][dispatch][events]") {
+    Simulator simulator;
+    auto eth = std::make_shared<RecordingStrategy>();
+    eth->subscribe("ETH-USD", BOOK_UPDATES);
+    eth->subscribeBookEvents(false);
+    simulator.registerStrategy(eth);
+
+    simulator.onMarketData(Order{1, "BTC-USD", OrderType::LIMIT, Side::SELL, 200.0, 1, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 100.0, 1, 1100});
+
+    REQUIRE(eth->ticks.empty());
+    REQUIRE(eth->events.size() == 1);
+    REQUIRE(eth->events[0].instrument == "ETH-USD");
+}
+
+TEST_CASE("Auction trades reach strategies at the uncross", "[simulator][auction]") {
+    Simulator simulator;
+    auto recorder = std::make_shared<RecordingStrategy>();
+    recorder->subscribeBookEvents();
+    simulator.registerStrategy(recorder);
+
+    simulator.startAuction("ETH-USD");
+    simulator.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 101.0, 3, 1000});
+    simulator.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 99.0, 2, 1100});
+    REQUIRE(recorder->ticks.size() == 2);
+    REQUIRE(recorder->fills.empty());
+
+    simulator.uncross("ETH-USD", 100.0);
+    REQUIRE(recorder->fills.size() == 1);
+    REQUIRE(recorder->events.back().traded_quantity == 2);
+    REQUIRE(recorder->events.back().last_trade_price == 101.0);  // buy surplus lifts the price
+    REQUIRE(simulator.getBook("ETH-USD").topOfBook().bid_size == 1);
+}
@@ -0,0 +1,72 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/static_host.hpp"
+#include "core/order.hpp"
+#include "core/trade.hpp"
+
+#include <vector>
+
+using namespace core;
+using namespace engine;
+
+namespace {
+
+// Lifts every ask it sees and sells back what it bought, once.
+struct LiftAndFlip {
+    std::vector<Trade> trades;
+    bool flipped = false;
+
+    template <typename Sink>
+    void onMarketData(const Order& tick, Sink& submit) {
+        if (tick.side == Side::SELL) {
+            submit(Order{tick.id + 1000, tick.instrument, OrderType::LIMIT, Side::BUY, tick.price, tick.quantity, tick.timestamp});
+        }
+    }
+
+    template <typename Sink>
+    void onTrade(const Trade& trade, Sink& submit) {
+        trades.push_back(trade);
+        if (!flipped && trade.buy_order_id > 1000) {
+            flipped = true;
+            submit(Order{9000, trade.instrument, OrderType::MARKET, Side::SELL, 0.0, trade.quantity, trade.timestamp});
+        }
+    }
+};
+
+// Records submissions without matching them.
+struct RecordingSink {
+    std::vector<Order> orders;
+    void operator()(const Order& order) { orders.push_back(order); }
+};
+
+}
+
+TEST_CASE("StaticHost matches ticks and strategy orders in the sink's books", "[static_host]") {
+    StaticHost<LiftAndFlip, BookSink<>> host(BookSink<>{}, LiftAndFlip{});
+
+    host.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::BUY, 99.0, 2, 1000});
+    host.onMarketData(Order{2, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1100});
+
+    // the lift of order 2, then the flip into the resting bid at 99
+    const auto& trades = host.strategy().trades;
+    REQUIRE(trades.size() == 2);
+    REQUIRE(trades[0].sell_order_id == 2);
+    REQUIRE(trades[0].buy_order_id == 1002);
+    REQUIRE(trades[1].sell_order_id == 9000);
+    REQUIRE(trades[1].price == 99.0);
+
+    REQUIRE(host.sink().trades().empty());
+    REQUIRE(host.sink().book("ETH-USD").topOfBook().bid_size == 1);
+}
+
+TEST_CASE("StaticHost works with a sink that does not match", "[static_host]") {
+    StaticHost<LiftAndFlip, RecordingSink> host(RecordingSink{}, LiftAndFlip{});
+
+    host.onMarketData(Order{1, "ETH-USD", OrderType::LIMIT, Side::SELL, 101.0, 1, 1000});
+    host.onTrade(Trade{1, 1001, 1, "ETH-USD", 101.0, 1, 1000, Side::BUY});
+
+    REQUIRE(host.sink().orders.size() == 2);
+    REQUIRE(host.sink().orders[0].side == Side::BUY);
+    REQUIRE(host.sink().orders[1].type == OrderType::MARKET);
+}
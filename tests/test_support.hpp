@@ -0,0 +1,50 @@
+/**
+ * @file test_support.hpp
+ * @brief Fixtures shared by the journal and checkpoint tests.
+ */
+
+#pragma once
+
+#include "strategy/strategy.hpp"
+#include "core/order.hpp"
+#include "core/trade.hpp"
+
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace test_support {
+
+inline std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Collects every trade the engine prints.
+class TradeTape : public strategy::Strategy {
+public:
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t, double, uint32_t>> trades;
+
+    void start() override {}
+    void stop() override {}
+    void onMarketData(const core::Order&) override {}
+    void onTrade(const core::Trade& t) override { trades.emplace_back(t.trade_id, t.buy_order_id, t.sell_order_id, t.price, t.quantity); }
+    std::string name() const override { return "TradeTape"; }
+    void printSummary() const override {}
+    void exportSummary(const std::string&) const override {}
+};
+
+// Two-sided ETH-USD flow that drifts up and down, so resting orders keep trading.
+inline std::vector<core::Order> choppyTicks() {
+    using namespace core;
+    std::vector<Order> ticks;
+    for (uint64_t i = 0; i < 200; ++i) {
+        double drift = static_cast<double>(i % 20) * (i % 40 < 20 ? 0.5 : -0.5);
+        Side side = (i % 3) ? Side::BUY : Side::SELL;
+        double price = 100.0 + drift + (side == Side::BUY ? -0.2 : 0.2);
+        ticks.emplace_back(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, side, price, 1 + i % 4, 1'000'000 + i * 150'000);
+    }
+    return ticks;
+}
+
+}
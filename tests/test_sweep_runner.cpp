@@ -0,0 +1,64 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/sweep_runner.hpp"
+#include "strategy/momentum_trader.hpp"
+#include "core/order.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+
+namespace {
+
+std::shared_ptr<const std::vector<Order>> trendingTicks() {
+    auto ticks = std::make_shared<std::vector<Order>>();
+    for (uint64_t i = 0; i < 50; ++i) {
+        double price = 100.0 + static_cast<double>(i % 10) * (i < 25 ? 1.0 : -1.0);
+        Side side = (i % 2) ? Side::BUY : Side::SELL;
+        ticks->emplace_back(Order::global_order_id++, "ETH-USD", OrderType::LIMIT, side, price, 1, 1'000'000 + i * 100'000);
+    }
+    return ticks;
+}
+
+SweepRunner::StrategyFactory momentumFactory() {
+    return [](Simulator& sim, const SweepParams& p) {
+        auto strat = std::make_shared<MomentumTrader>("ETH-USD", sim.makeSubmitter(1), p.risk);
+        strat->setLogDirectory("");
+        return strat;
+    };
+}
+
+}
+
+TEST_CASE("SweepRunner builds the cartesian grid in order", "[sweep]") {
+    auto grid = SweepRunner::grid({0.01, 0.02}, {5}, {-100.0, -500.0});
+
+    REQUIRE(grid.size() == 4);
+    REQUIRE(grid[0].spread == 0.01);
+    REQUIRE(grid[1].risk == -500.0);
+    REQUIRE(grid[2].spread == 0.02);
+    REQUIRE(grid[3].size == 5);
+}
+
+TEST_CASE("SweepRunner parallel results match serial runs", "[sweep]") {
+    auto ticks = trendingTicks();
+    SweepRunner runner(ticks, momentumFactory(), 4);
+    auto grid = SweepRunner::grid({0.01}, {1, 2, 3}, {-1.0, -50.0, -5000.0});
+
+    auto results = runner.run(grid);
+
+    REQUIRE(results.size() == grid.size());
+    for (std::size_t i = 0; i < grid.size(); ++i) {
+        SweepResult serial = runner.runOne(grid[i]);
+        REQUIRE(results[i].params.risk == grid[i].risk);
+        REQUIRE(results[i].total_trades == serial.total_trades);
+        REQUIRE(results[i].realized_pnl == serial.realized_pnl);
+        REQUIRE(results[i].risk_breached == serial.risk_breached);
+    }
+
+    REQUIRE(results[0].total_trades > 0);
+}
@@ -0,0 +1,143 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/thread_pool.hpp"
+#include "engine/simulator.hpp"
+#include "strategy/strategy.hpp"
+#include "core/order.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace core;
+using namespace engine;
+using namespace strategy;
+
+namespace {
+
+// Counts callbacks and checks that no two of them ever overlap.
+class CountingStrategy : public Strategy {
+public:
+    std::atomic<int> ticks{0};
+    std::atomic<int> in_flight{0};
+    std::atomic<bool> overlapped{false};
+
+    void start() override {}
+    void stop() override {}
+    void onMarketData(const Order&) override {
+        if (in_flight.fetch_add(1) != 0) overlapped = true;
+        ++ticks;
+        in_flight.fetch_sub(1);
+    }
+    void onTrade(const Trade&) override {}
+    std::string name() const override { return "Counting"; }
+    void printSummary() const override {}
+    void exportSummary(const std::string&) const override {}
+};
+
+template <typename Pred>
+bool waitFor(Pred pred) {
+    for (int i = 0; i < 500 && !pred(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return pred();
+}
+
+}
+
+TEST_CASE("ThreadPool runs every task submitted from many threads", "[thread_pool]") {
+    std::atomic<int> done{0};
+    std::atomic<int> nested{0};
+    {
+        ThreadPool pool(4);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back([&] {
+                for (int i = 0; i < 1000; ++i) {
+                    pool.submit([&, i] {
+                        ++done;
+                        // nested submits land on the worker's own deque
+                        if (i % 100 == 0) pool.submit([&] { ++nested; });
+                    });
+                }
+            });
+        }
+        for (auto& p : producers) p.join();
+    }
+    REQUIRE(done == 4000);
+    REQUIRE(nested == 40);
+}
+
+TEST_CASE("Strand runs its tasks one at a time and in order", "[thread_pool]") {
+    ThreadPool pool(4);
+    auto strand = std::make_shared<Strand>(pool);
+
+    std::vector<int> order;   // only touched on the strand
+    std::atomic<int> in_flight{0};
+    std::atomic<bool> overlapped{false};
+    for (int i = 0; i < 1000; ++i) {
+        strand->post([&, i] {
+            if (in_flight.fetch_add(1) != 0) overlapped = true;
+            order.push_back(i);
+            in_flight.fetch_sub(1);
+        });
+    }
+    strand->invoke([] {});
+
+    REQUIRE_FALSE(overlapped);
+    REQUIRE(order.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("Strand invoke propagates exceptions to the caller", "[thread_pool]") {
+    ThreadPool pool(2);
+    auto strand = std::make_shared<Strand>(pool);
+
+    REQUIRE_THROWS_AS(strand->invoke([] { throw std::runtime_error("boom"); }), std::runtime_error);
+
+    bool ran = false;
+    strand->invoke([&] { ran = true; });
+    REQUIRE(ran);
+}
+
+TEST_CASE("StrandClock delivers timers on the strand and stops on cancel", "[thread_pool][clock]") {
+    ThreadPool pool(2);
+    auto strand = std::make_shared<Strand>(pool);
+    StrandClock clock(std::make_shared<RealTimeClock>(), strand);
+
+    std::atomic<int> fired{0};
+    auto id = clock.schedule(1000, 1000, [&] { ++fired; });
+    REQUIRE(waitFor([&] { return fired >= 3; }));
+
+    clock.cancel(id);
+    strand->invoke([] {});
+    int after_cancel = fired;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(fired == after_cancel);
+}
+
+TEST_CASE("Simulator hosts live strategies on the executor", "[thread_pool][simulator]") {
+    auto pool = std::make_shared<ThreadPool>(2);
+    Simulator simulator(std::make_shared<RealTimeClock>(), pool);
+    auto a = std::make_shared<CountingStrategy>();
+    auto b = std::make_shared<CountingStrategy>();
+    simulator.registerStrategy(a);
+    simulator.registerStrategy(b);
+
+    simulator.start();
+    for (uint64_t i = 1; i <= 200; ++i) {
+        simulator.onMarketData(Order{i, "ETH-USD", OrderType::LIMIT, Side::BUY, 100.0 - static_cast<double>(i % 5), 1, i});
+    }
+    simulator.stop();
+
+    // stop() runs behind everything already queued for each strategy
+    REQUIRE(a->ticks == 200);
+    REQUIRE(b->ticks == 200);
+    REQUIRE_FALSE(a->overlapped);
+    REQUIRE_FALSE(b->overlapped);
+}